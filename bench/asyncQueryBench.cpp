@@ -0,0 +1,134 @@
+/*
+    Queries/s with N queries in flight at once, run either the blocking way with one thread per
+   in-flight query, or as N coroutines over AsyncConnection on a single EventLoop thread. Each
+   side has its N connections opened before timing starts.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AsyncConnection.h"
+#include "SqlTypes/TextParse.hpp"
+#include "benchConnection.h"
+#include "makeBinds.hpp"
+
+using namespace set_mysql_binds;
+
+static constexpr const char* benchQuery = "SELECT 1, 'row'";
+
+static BindsArray<OutputCType> makeResultBinds() {
+   return makeOutputBindsArray( Bind<INT>( "one" ), Bind<VARCHAR>( "name", 16 ) );
+}
+
+static void BM_ThreadPerQuery( benchmark::State& state ) {
+   ConnectionOptions options;
+   std::string error;
+   if ( !bench::benchConnectionOptions( options, error ) ) {
+      state.SkipWithError( error.c_str() );
+      return;
+   }
+   size_t inFlight = static_cast<size_t>( state.range( 0 ) );
+   std::vector<MYSQL*> connections;
+   try {
+      for ( size_t i = 0; i < inFlight; ++i ) {
+         connections.push_back( openConnection( options ) );
+      }
+   } catch ( const std::exception& e ) {
+      state.SkipWithError( e.what() );
+   }
+
+   std::atomic<bool> failed = false;
+   for ( auto _ : state ) {
+      if ( connections.size() < inFlight ) {
+         break;
+      }
+      std::vector<std::jthread> threads;
+      for ( MYSQL* conn : connections ) {
+         threads.emplace_back( [ conn, &failed ] {
+            auto result = makeResultBinds();
+            MYSQL_RES* res = nullptr;
+            if ( mysql_query( conn, benchQuery ) ||
+                 ( res = mysql_store_result( conn ) ) == nullptr ) {
+               failed = true;
+               return;
+            }
+            MYSQL_BIND* binds = result.getBinds();
+            while ( MYSQL_ROW row = mysql_fetch_row( res ) ) {
+               unsigned long* lengths = mysql_fetch_lengths( res );
+               textToBind( binds[ 0 ], row[ 0 ], lengths[ 0 ] );
+               textToBind( binds[ 1 ], row[ 1 ], lengths[ 1 ] );
+            }
+            mysql_free_result( res );
+         } );
+      }
+   }
+   if ( failed ) {
+      state.SkipWithError( "query failed" );
+   }
+   state.SetItemsProcessed( static_cast<int64_t>( state.iterations() * inFlight ) );
+   for ( MYSQL* conn : connections ) {
+      mysql_close( conn );
+   }
+}
+BENCHMARK( BM_ThreadPerQuery )
+    ->RangeMultiplier( 4 )
+    ->Range( 4, 256 )
+    ->Unit( benchmark::kMicrosecond )
+    ->UseRealTime();
+
+static Task<void> connectTo( AsyncConnection& conn, const ConnectionOptions& options ) {
+   co_await conn.connect( options );
+}
+
+static Task<void> runQuery( AsyncConnection& conn, BindsArray<OutputCType>& result ) {
+   co_await conn.query( benchQuery );
+   while ( co_await conn.fetchRow( result ) ) {
+   }
+}
+
+static void BM_Coroutines( benchmark::State& state ) {
+   ConnectionOptions options;
+   std::string error;
+   if ( !bench::benchConnectionOptions( options, error ) ) {
+      state.SkipWithError( error.c_str() );
+      return;
+   }
+   size_t inFlight = static_cast<size_t>( state.range( 0 ) );
+   EventLoop loop;
+   std::vector<std::unique_ptr<AsyncConnection>> connections;
+   std::vector<BindsArray<OutputCType>> results;
+   try {
+      for ( size_t i = 0; i < inFlight; ++i ) {
+         connections.push_back( std::make_unique<AsyncConnection>( loop ) );
+         results.push_back( makeResultBinds() );
+         loop.spawn( connectTo( *connections.back(), options ) );
+      }
+      loop.run();
+   } catch ( const std::exception& e ) {
+      state.SkipWithError( e.what() );
+      return;
+   }
+
+   for ( auto _ : state ) {
+      for ( size_t i = 0; i < inFlight; ++i ) {
+         loop.spawn( runQuery( *connections[ i ], results[ i ] ) );
+      }
+      try {
+         loop.run();
+      } catch ( const std::exception& e ) {
+         state.SkipWithError( e.what() );
+         break;
+      }
+   }
+   state.SetItemsProcessed( static_cast<int64_t>( state.iterations() * inFlight ) );
+}
+BENCHMARK( BM_Coroutines )
+    ->RangeMultiplier( 4 )
+    ->Range( 4, 256 )
+    ->Unit( benchmark::kMicrosecond )
+    ->UseRealTime();
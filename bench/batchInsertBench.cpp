@@ -0,0 +1,98 @@
+/*
+    Rows/s of the single-row INSERT path (one mysql_stmt_execute() per row through a
+   makeInputBindsArray() array) against BatchInsert with different batch sizes.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "BatchInsert.h"
+#include "benchConnection.h"
+#include "makeBinds.hpp"
+
+using namespace set_mysql_binds;
+
+static constexpr const char* benchTable = "set_mysql_binds_bench_rows";
+
+static MYSQL* setUpTable( benchmark::State& state ) {
+   std::string error;
+   MYSQL* conn = bench::openBenchConnection( error );
+   if ( conn == nullptr ) {
+      state.SkipWithError( error.c_str() );
+      return nullptr;
+   }
+   if ( mysql_query( conn, "CREATE TABLE IF NOT EXISTS set_mysql_binds_bench_rows "
+                           "(id INT, name VARCHAR(64), amount DOUBLE)" ) ||
+        mysql_query( conn, "TRUNCATE TABLE set_mysql_binds_bench_rows" ) ) {
+      state.SkipWithError( mysql_error( conn ) );
+      mysql_close( conn );
+      return nullptr;
+   }
+   return conn;
+}
+
+static BindsArray<InputCType> makeRowBinds() {
+   return makeInputBindsArray( Bind<INT>( "id" ), Bind<VARCHAR>( "name", 64 ),
+                               Bind<DOUBLE>( "amount" ) );
+}
+
+static void setRow( BindsArray<InputCType>& binds, long row ) {
+   binds[ 0 ] = static_cast<long double>( row );
+   binds[ 1 ] = std::string( "row " ) + std::to_string( row );
+   binds[ 2 ] = static_cast<long double>( row ) * 0.25L;
+}
+
+static void BM_SingleRowInsert( benchmark::State& state ) {
+   MYSQL* conn = setUpTable( state );
+   if ( conn == nullptr ) {
+      return;
+   }
+   auto binds = makeRowBinds();
+   std::string query = std::string( "INSERT INTO " ) + benchTable + " VALUES (?,?,?)";
+   MYSQL_STMT* stmt = mysql_stmt_init( conn );
+   if ( mysql_stmt_prepare( stmt, query.c_str(), query.size() ) ||
+        mysql_stmt_bind_param( stmt, binds.getBinds() ) ) {
+      state.SkipWithError( mysql_stmt_error( stmt ) );
+   } else {
+      long row = 0;
+      for ( auto _ : state ) {
+         setRow( binds, row++ );
+         if ( mysql_stmt_execute( stmt ) ) {
+            state.SkipWithError( mysql_stmt_error( stmt ) );
+            break;
+         }
+      }
+      state.SetItemsProcessed( row );
+   }
+   mysql_stmt_close( stmt );
+   mysql_close( conn );
+}
+BENCHMARK( BM_SingleRowInsert )->Unit( benchmark::kMicrosecond );
+
+static void BM_BatchInsert( benchmark::State& state ) {
+   MYSQL* conn = setUpTable( state );
+   if ( conn == nullptr ) {
+      return;
+   }
+   auto binds = makeRowBinds();
+   long row = 0;
+   {
+      BatchInsert batch( conn, benchTable, binds, static_cast<size_t>( state.range( 0 ) ) );
+      try {
+         for ( auto _ : state ) {
+            setRow( binds, row++ );
+            batch.addRow();
+         }
+         batch.flush();
+      } catch ( const std::exception& e ) {
+         state.SkipWithError( e.what() );
+      }
+   }
+   state.SetItemsProcessed( row );
+   mysql_close( conn );
+}
+BENCHMARK( BM_BatchInsert )
+    ->RangeMultiplier( 4 )
+    ->Range( 16, 1024 )
+    ->Unit( benchmark::kMicrosecond );
@@ -0,0 +1,63 @@
+#ifndef INCLUDED_BENCHCONNECTION_H
+#define INCLUDED_BENCHCONNECTION_H
+
+#include <mysql/mysql.h>
+
+#include <cstdlib>
+#include <string>
+
+#include "ConnectionPool.h"
+
+/*
+    Connection used by the server benchmarks. They run against a local mysqld described by the
+   SET_MYSQL_BINDS_BENCH_HOST, SET_MYSQL_BINDS_BENCH_USER, SET_MYSQL_BINDS_BENCH_PASSWORD and
+   SET_MYSQL_BINDS_BENCH_DATABASE environment variables and are skipped when those are not set.
+*/
+
+namespace set_mysql_binds::bench {
+
+inline std::string benchEnv( const char* name ) {
+   const char* value = std::getenv( name );
+   return value ? value : "";
+}
+
+// False, with the reason in error, when no server is configured
+inline bool benchConnectionOptions( ConnectionOptions& options, std::string& error ) {
+   options.host = benchEnv( "SET_MYSQL_BINDS_BENCH_HOST" );
+   options.user = benchEnv( "SET_MYSQL_BINDS_BENCH_USER" );
+   options.password = benchEnv( "SET_MYSQL_BINDS_BENCH_PASSWORD" );
+   options.database = benchEnv( "SET_MYSQL_BINDS_BENCH_DATABASE" );
+   if ( options.host.empty() || options.database.empty() ) {
+      error = "SET_MYSQL_BINDS_BENCH_HOST/_DATABASE not set, no server to benchmark against";
+      return false;
+   }
+   return true;
+}
+
+// Returns nullptr, with the reason in error, when no server is configured or reachable
+inline MYSQL* openBenchConnection( std::string& error ) {
+   std::string host = benchEnv( "SET_MYSQL_BINDS_BENCH_HOST" );
+   std::string database = benchEnv( "SET_MYSQL_BINDS_BENCH_DATABASE" );
+   if ( host.empty() || database.empty() ) {
+      error = "SET_MYSQL_BINDS_BENCH_HOST/_DATABASE not set, no server to benchmark against";
+      return nullptr;
+   }
+
+   MYSQL* conn = mysql_init( nullptr );
+   if ( conn == nullptr ) {
+      error = "mysql_init() failed";
+      return nullptr;
+   }
+   if ( mysql_real_connect( conn, host.c_str(), benchEnv( "SET_MYSQL_BINDS_BENCH_USER" ).c_str(),
+                            benchEnv( "SET_MYSQL_BINDS_BENCH_PASSWORD" ).c_str(), database.c_str(),
+                            0, nullptr, 0 ) == nullptr ) {
+      error = mysql_error( conn );
+      mysql_close( conn );
+      return nullptr;
+   }
+   return conn;
+}
+
+}  // namespace set_mysql_binds::bench
+
+#endif  // INCLUDED_BENCHCONNECTION_H
@@ -0,0 +1,74 @@
+#ifndef INCLUDED_BENCHROWS_H
+#define INCLUDED_BENCHROWS_H
+
+#include <array>
+#include <string_view>
+#include <utility>
+
+#include "makeBinds.hpp"
+
+/*
+    The rows the benchmarks share. The narrow row is the five columns id INT, count BIGINT,
+   amount DOUBLE, name VARCHAR(64) and created DATETIME, the wide one 40 columns c0 to c39 cycling
+   through those five types. A benchmark needing a column more passes its binds to the narrow
+   factories, which append them after created.
+*/
+
+namespace set_mysql_binds::bench {
+
+inline constexpr size_t narrowColumns = 5;
+inline constexpr size_t wideColumns = 40;
+
+inline constexpr std::array<MysqlInputType, narrowColumns> narrowTypes = { INT, BIGINT, DOUBLE,
+                                                                           VARCHAR, DATETIME };
+
+inline constexpr std::array<std::string_view, wideColumns> wideNames = {
+    "c0",  "c1",  "c2",  "c3",  "c4",  "c5",  "c6",  "c7",  "c8",  "c9",
+    "c10", "c11", "c12", "c13", "c14", "c15", "c16", "c17", "c18", "c19",
+    "c20", "c21", "c22", "c23", "c24", "c25", "c26", "c27", "c28", "c29",
+    "c30", "c31", "c32", "c33", "c34", "c35", "c36", "c37", "c38", "c39" };
+
+template <MysqlInputType... Extra>
+BindsArray<InputCType> makeNarrowInput( Bind<Extra>... extra ) {
+   return makeInputBindsArray( Bind<INT>( "id" ), Bind<BIGINT>( "count" ), Bind<DOUBLE>( "amount" ),
+                               Bind<VARCHAR>( "name", 64 ), Bind<DATETIME>( "created" ), extra... );
+}
+
+template <MysqlInputType... Extra>
+BindsArray<OutputCType> makeNarrowOutput( Bind<Extra>... extra ) {
+   return makeOutputBindsArray( Bind<INT>( "id" ), Bind<BIGINT>( "count" ),
+                                Bind<DOUBLE>( "amount" ), Bind<VARCHAR>( "name", 64 ),
+                                Bind<DATETIME>( "created" ), extra... );
+}
+
+namespace detail {
+
+template <size_t I>
+auto wideBind() {
+   constexpr MysqlInputType type = narrowTypes[ I % narrowColumns ];
+   return Bind<type>( wideNames[ I ], type == VARCHAR ? 64 : 0 );
+}
+
+template <size_t... I>
+BindsArray<InputCType> makeWideInput( std::index_sequence<I...> ) {
+   return makeInputBindsArray( wideBind<I>()... );
+}
+
+template <size_t... I>
+BindsArray<OutputCType> makeWideOutput( std::index_sequence<I...> ) {
+   return makeOutputBindsArray( wideBind<I>()... );
+}
+
+}  // namespace detail
+
+inline BindsArray<InputCType> makeWideInput() {
+   return detail::makeWideInput( std::make_index_sequence<wideColumns>() );
+}
+
+inline BindsArray<OutputCType> makeWideOutput() {
+   return detail::makeWideOutput( std::make_index_sequence<wideColumns>() );
+}
+
+}  // namespace set_mysql_binds::bench
+
+#endif  // INCLUDED_BENCHROWS_H
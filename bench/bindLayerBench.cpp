@@ -0,0 +1,343 @@
+/*
+    The per row costs of the dynamic bind layer, none of which needs a server: building a
+   BindsArray for a narrow (5 column) and a wide (40 column) table, re-binding a selection,
+   column lookup by name (hash map and FieldHash), by column ID and by index, each
+   InImpl::operator= overload against the typed set() under each checking policy, print_value and
+   a simulated fetch that writes a row into the bound buffers the way mysql_stmt_fetch() does.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchRows.h"
+#include "makeBinds.hpp"
+
+using namespace set_mysql_binds;
+
+using bench::makeNarrowInput;
+using bench::makeNarrowOutput;
+using bench::wideColumns;
+using bench::wideNames;
+
+static BindsArray<OutputCType> makeOutput( size_t columns ) {
+   return columns == wideColumns ? bench::makeWideOutput() : makeNarrowOutput();
+}
+
+// Construction ***********************************************************************************
+
+static void BM_MakeInputNarrow( benchmark::State& state ) {
+   for ( auto _ : state ) {
+      auto binds = makeNarrowInput();
+      benchmark::DoNotOptimize( binds.getBinds() );
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_MakeInputNarrow );
+
+static void BM_MakeInputWide( benchmark::State& state ) {
+   for ( auto _ : state ) {
+      auto binds = bench::makeWideInput();
+      benchmark::DoNotOptimize( binds.getBinds() );
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_MakeInputWide );
+
+static void BM_MakeOutput( benchmark::State& state ) {
+   const auto columns = static_cast<size_t>( state.range( 0 ) );
+   for ( auto _ : state ) {
+      auto binds = makeOutput( columns );
+      benchmark::DoNotOptimize( binds.getBinds() );
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_MakeOutput )->Arg( 5 )->Arg( wideColumns );
+
+// Selection **************************************************************************************
+
+// Binds every other column by name, then all of them again
+static void BM_SetBindsSelection( benchmark::State& state ) {
+   const auto columns = static_cast<size_t>( state.range( 0 ) );
+   auto binds = makeOutput( columns );
+   std::vector<std::string_view> selection;
+   for ( size_t c = 0; c < columns; c += 2 ) {
+      selection.push_back( binds.fields[ c ]->fieldName );
+   }
+   for ( auto _ : state ) {
+      binds.setBinds( selection );
+      benchmark::DoNotOptimize( binds.getBinds() );
+      for ( auto* field : binds.fields ) {
+         field->is_selected = true;
+      }
+      binds.setBinds();
+      benchmark::DoNotOptimize( binds.getBinds() );
+   }
+   state.SetItemsProcessed( state.iterations() * 2 );
+}
+BENCHMARK( BM_SetBindsSelection )->Arg( 5 )->Arg( wideColumns );
+
+// Lookup *****************************************************************************************
+
+static void BM_LookupByName( benchmark::State& state ) {
+   auto binds = bench::makeWideInput();
+   for ( auto _ : state ) {
+      for ( std::string_view name : wideNames ) {
+         benchmark::DoNotOptimize( &binds[ name ] );
+      }
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( wideColumns ) );
+}
+BENCHMARK( BM_LookupByName );
+
+static constexpr FieldHash<wideColumns> wideHash( wideNames );
+
+static void BM_LookupByFieldHash( benchmark::State& state ) {
+   auto binds = bench::makeWideInput();
+   binds.useFieldHash( wideHash );
+   for ( auto _ : state ) {
+      for ( std::string_view name : wideNames ) {
+         benchmark::DoNotOptimize( &binds[ name ] );
+      }
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( wideColumns ) );
+}
+BENCHMARK( BM_LookupByFieldHash );
+
+enum class WideColumn : size_t {};
+
+static void BM_LookupById( benchmark::State& state ) {
+   auto binds = bench::makeWideInput();
+   for ( auto _ : state ) {
+      for ( size_t c = 0; c < wideColumns; ++c ) {
+         benchmark::DoNotOptimize( &binds[ static_cast<WideColumn>( c ) ] );
+      }
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( wideColumns ) );
+}
+BENCHMARK( BM_LookupById );
+
+static void BM_LookupByIndex( benchmark::State& state ) {
+   auto binds = bench::makeWideInput();
+   for ( auto _ : state ) {
+      for ( size_t c = 0; c < wideColumns; ++c ) {
+         benchmark::DoNotOptimize( &binds[ c ] );
+      }
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( wideColumns ) );
+}
+BENCHMARK( BM_LookupByIndex );
+
+// InImpl::operator= and set() ********************************************************************
+
+static void BM_AssignLongDouble( benchmark::State& state ) {
+   auto binds = makeNarrowInput();
+   InputCType& count = binds[ 1 ];
+   long i = 0;
+   for ( auto _ : state ) {
+      count = static_cast<long double>( i++ );
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_AssignLongDouble );
+
+static void BM_AssignLongDoubleStrict( benchmark::State& state ) {
+   auto binds = makeNarrowInput();
+   InputCType& count = binds[ 1 ];
+   strict_fundamental_type_checking = true;
+   long i = 0;
+   for ( auto _ : state ) {
+      count = static_cast<long double>( i++ );
+      benchmark::ClobberMemory();
+   }
+   strict_fundamental_type_checking = false;
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_AssignLongDoubleStrict );
+
+// The typed set() path under each checking policy
+template <typename Checking>
+static void BM_SetTyped( benchmark::State& state ) {
+   BindsArray<InputCType, Checking> binds = makeNarrowInput();
+   InputCType& count = binds[ 1 ];
+   long i = 0;
+   for ( auto _ : state ) {
+      count.set<BIGINT, Checking>( i++ );
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_SetTyped<StrictChecking> );
+BENCHMARK( BM_SetTyped<NarrowingChecking> );
+BENCHMARK( BM_SetTyped<NoChecking> );
+
+// A row of an ingest loop, every numeric column written through the BindsArray by column ID
+enum class NarrowColumn : size_t { id, count, amount, name, created };
+
+template <typename Checking>
+static void BM_SetRow( benchmark::State& state ) {
+   BindsArray<InputCType, Checking> binds = makeNarrowInput();
+   int i = 0;
+   for ( auto _ : state ) {
+      binds.template set<INT>( NarrowColumn::id, i );
+      binds.template set<BIGINT>( NarrowColumn::count, static_cast<long>( i ) * 1000 );
+      binds.template set<DOUBLE>( NarrowColumn::amount, i * 0.5 );
+      ++i;
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed( state.iterations() * 3 );
+}
+BENCHMARK( BM_SetRow<StrictChecking> );
+BENCHMARK( BM_SetRow<NoChecking> );
+
+static void BM_AssignRow( benchmark::State& state ) {
+   auto binds = makeNarrowInput();
+   int i = 0;
+   for ( auto _ : state ) {
+      binds[ 0 ] = static_cast<long double>( i );
+      binds[ 1 ] = static_cast<long double>( static_cast<long>( i ) * 1000 );
+      binds[ 2 ] = static_cast<long double>( i * 0.5 );
+      ++i;
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed( state.iterations() * 3 );
+}
+BENCHMARK( BM_AssignRow );
+
+static void BM_AssignString( benchmark::State& state ) {
+   auto binds = makeNarrowInput();
+   InputCType& name = binds[ 3 ];
+   const std::string value = "benchmark row";
+   for ( auto _ : state ) {
+      name = value;
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_AssignString );
+
+static void BM_AssignNumericString( benchmark::State& state ) {
+   auto binds = makeNarrowInput();
+   InputCType& count = binds[ 1 ];
+   const std::string value = "9876543210";
+   for ( auto _ : state ) {
+      count = value;
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_AssignNumericString );
+
+static void BM_AssignBytes( benchmark::State& state ) {
+   auto binds = makeNarrowInput();
+   InputCType& name = binds[ 3 ];
+   const std::array<unsigned char, 13> value = { 'b', 'e', 'n', 'c', 'h', 'm', 'a',
+                                                 'r', 'k', ' ', 'r', 'o', 'w' };
+   for ( auto _ : state ) {
+      name = std::span<const unsigned char>( value );
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_AssignBytes );
+
+static void BM_AssignTime( benchmark::State& state ) {
+   auto binds = makeNarrowInput();
+   InputCType& created = binds[ 4 ];
+   MYSQL_TIME value{};
+   value.year = 2024;
+   value.month = 3;
+   value.day = 9;
+   for ( auto _ : state ) {
+      created = value;
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_AssignTime );
+
+// print_value ************************************************************************************
+
+static void BM_PrintValue( benchmark::State& state ) {
+   auto binds = makeNarrowInput();
+   binds[ 0 ] = 123456.0L;
+   binds[ 1 ] = 9876543210.0L;
+   binds[ 2 ] = 1234.5678L;
+   binds[ 3 ] = std::string( "benchmark row" );
+   binds[ 4 ] = std::string( "2024-03-09 17:05:42" );
+   std::ostringstream os;
+   for ( auto _ : state ) {
+      os.str( "" );
+      for ( auto* field : binds.fields ) {
+         field->print_value( os );
+      }
+      benchmark::DoNotOptimize( os );
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( binds.fields.size() ) );
+}
+BENCHMARK( BM_PrintValue );
+
+// Fetch ******************************************************************************************
+
+// What mysql_stmt_fetch() leaves in the binds for one row: the value bytes, length and is_null
+static void simulateFetch( std::span<MYSQL_BIND> binds, std::span<const std::string> wire ) {
+   for ( size_t c = 0; c < binds.size(); ++c ) {
+      MYSQL_BIND& bind = binds[ c ];
+      const std::string& value = wire[ c ];
+      unsigned long copied = std::min<unsigned long>( value.size(), bind.buffer_length );
+      if ( !fixedBufferSize( bind.buffer_type ) ) {
+         std::memcpy( bind.buffer, value.data(), copied );
+      } else {
+         std::memcpy( bind.buffer, value.data(), value.size() );
+      }
+      *bind.length = static_cast<unsigned long>( value.size() );
+      *bind.is_null = false;
+      *bind.error = copied < value.size() && !fixedBufferSize( bind.buffer_type );
+   }
+}
+
+// The binary protocol image of each bound column
+static std::vector<std::string> wireRow( BindsArray<OutputCType>& binds ) {
+   std::vector<std::string> wire;
+   const MYSQL_BIND* bound = binds.getBinds();
+   for ( size_t c = 0; c < binds.getBindsSize(); ++c ) {
+      size_t size = fixedBufferSize( bound[ c ].buffer_type );
+      wire.push_back( size ? std::string( size, '\1' ) : std::string( "benchmark row" ) );
+   }
+   return wire;
+}
+
+static void BM_SimulatedFetch( benchmark::State& state ) {
+   auto binds = makeOutput( static_cast<size_t>( state.range( 0 ) ) );
+   std::vector<std::string> wire = wireRow( binds );
+   for ( auto _ : state ) {
+      simulateFetch( { binds.getBinds(), binds.getBindsSize() }, wire );
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_SimulatedFetch )->Arg( 5 )->Arg( wideColumns );
+
+// A fetch followed by reading every column back through the BindsArray by name
+static void BM_SimulatedFetchAndRead( benchmark::State& state ) {
+   auto binds = makeNarrowOutput();
+   std::vector<std::string> wire = wireRow( binds );
+   for ( auto _ : state ) {
+      simulateFetch( { binds.getBinds(), binds.getBindsSize() }, wire );
+      benchmark::DoNotOptimize( *binds[ "id" ].Value<INT>() );
+      benchmark::DoNotOptimize( *binds[ "count" ].Value<BIGINT>() );
+      benchmark::DoNotOptimize( *binds[ "amount" ].Value<DOUBLE>() );
+      benchmark::DoNotOptimize( binds[ "name" ].view() );
+      benchmark::DoNotOptimize( binds[ "created" ].Value<DATETIME>()->year );
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_SimulatedFetchAndRead );
@@ -0,0 +1,264 @@
+/*
+    DECIMAL values of a fetched batch, the way reports read money columns: their text read as a
+   double with std::from_chars (what a char[] DECIMAL column offered), parseDecimal() one value at a
+   time and decodeDecimals() over a ColumnarColumn with the scalar, SSE4.1 and AVX2 decoders. The
+   input direction formats fixed point values with formatDecimal() against std::to_chars of the
+   double.
+
+    BM_DecodersAgree times nothing: it runs every decoder the CPU has over negatives, scale 0,
+   scales above 14, 17 to 38 digit values and text that is not a DECIMAL, and fails with the first
+   row where one differs from parseDecimal().
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <charconv>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Decimal.h"
+
+using namespace set_mysql_binds;
+
+static constexpr size_t batchRows = 4096;
+static constexpr unsigned int moneyScale = 2;
+
+// DECIMAL(15, 2) values as the server sends them, a NULL every 16th row
+static const ColumnarColumn& moneyColumn() {
+   static const ColumnarColumn column = [] {
+      ColumnarColumn c;
+      c.name = "amount";
+      c.bufferType = MYSQL_TYPE_NEWDECIMAL;
+      c.isUnsigned = false;
+      c.width = 0;
+      c.offsets.push_back( 0 );
+      c.validity.resize( ( batchRows + 7 ) / 8 );
+      std::mt19937_64 rng( 7 );
+      for ( size_t row = 0; row < batchRows; ++row ) {
+         if ( row % 16 != 15 ) {
+            Decimal value;
+            value.scale = moneyScale;
+            value.unscaled = static_cast<std::int64_t>( rng() % 10000000000000ULL ) - 5000000000000;
+            char text[ maxDecimalTextSize ];
+            char* end = formatDecimal( text, value );
+            c.data.insert( c.data.end(), text, end );
+            c.validity[ row / 8 ] |= static_cast<std::uint8_t>( 1U << ( row % 8 ) );
+         } else {
+            ++c.nullCount;
+         }
+         c.offsets.push_back( static_cast<std::int32_t>( c.data.size() ) );
+      }
+      return c;
+   }();
+   return column;
+}
+
+// A column of texts, all valid
+static ColumnarColumn textColumn( const std::vector<std::string>& texts ) {
+   ColumnarColumn c;
+   c.name = "checked";
+   c.bufferType = MYSQL_TYPE_NEWDECIMAL;
+   c.isUnsigned = false;
+   c.width = 0;
+   c.offsets.push_back( 0 );
+   c.validity.assign( ( texts.size() + 7 ) / 8, 0xff );
+   for ( const std::string& text : texts ) {
+      c.data.insert( c.data.end(), text.begin(), text.end() );
+      c.offsets.push_back( static_cast<std::int32_t>( c.data.size() ) );
+   }
+   return c;
+}
+
+// Random values of 1 to maxDigits digits and either sign formatted at scale, then forms the
+// server does not send but parseDecimal() takes or rejects
+template <typename Value>
+static std::vector<std::string> checkTexts( unsigned int scale, unsigned int maxDigits ) {
+   std::mt19937_64 rng( scale * 100 + maxDigits );
+   std::vector<std::string> texts;
+   for ( size_t row = 0; row < 2000; ++row ) {
+      BasicDecimal<Value> value;
+      value.scale = scale;
+      value.unscaled = 0;
+      const unsigned int digits = 1 + static_cast<unsigned int>( rng() % maxDigits );
+      for ( unsigned int digit = 0; digit < digits; ++digit ) {
+         value.unscaled = value.unscaled * 10 + static_cast<Value>( rng() % 10 );
+      }
+      if ( rng() % 2 ) {
+         value.unscaled = -value.unscaled;
+      }
+      char text[ maxDecimalTextSize ];
+      texts.emplace_back( text, formatDecimal( text, value ) );
+   }
+   for ( const char* text : { "+1.5", "1.5", ".5", "5.", "-.5", "-0", "0000012", "+0" } ) {
+      texts.emplace_back( text );
+   }
+   return texts;
+}
+
+// Whether decodeDecimals() with isa returns what parseDecimal() does row by row: the values up to
+// the first row it rejects and that row's index
+template <typename Value>
+static bool decodersAgree( const std::vector<std::string>& texts, unsigned int scale,
+                           DecimalIsa isa ) {
+   size_t firstBad = texts.size();
+   std::vector<Value> expected( texts.size() );
+   for ( size_t row = 0; row < texts.size(); ++row ) {
+      BasicDecimal<Value> value;
+      value.scale = scale;
+      if ( !parseDecimal( texts[ row ], value ) ) {
+         firstBad = row;
+         break;
+      }
+      expected[ row ] = value.unscaled;
+   }
+   const ColumnarColumn column = textColumn( texts );
+   std::vector<Value> out( texts.size() );
+   if ( decodeDecimals( column, texts.size(), scale, out, isa ) != firstBad ) {
+      return false;
+   }
+   for ( size_t row = 0; row < firstBad; ++row ) {
+      if ( out[ row ] != expected[ row ] ) {
+         return false;
+      }
+   }
+   return true;
+}
+
+// Text that is no DECIMAL, or none that fits
+static constexpr const char* malformedTexts[] = {
+    "1.2.3", "--1", "+-5", "1e5", "", "+", "-", ".", "12a.00", " 1", "1.00000000000000000000001",
+    "999999999999999999999999999999999999999" };
+
+// Returns the first ISA that differs from parseDecimal(), DecimalIsa::Best when none does
+template <typename Value>
+static DecimalIsa firstDisagreeing( unsigned int scale, unsigned int maxDigits ) {
+   const std::vector<std::string> texts = checkTexts<Value>( scale, maxDigits );
+   for ( auto isa : { DecimalIsa::Scalar, DecimalIsa::Sse41, DecimalIsa::Avx2 } ) {
+      if ( isa > bestDecimalIsa() ) {
+         break;
+      }
+      if ( !decodersAgree<Value>( texts, scale, isa ) ) {
+         return isa;
+      }
+      // Each malformed text after enough valid rows that the vector loops reach it
+      for ( const char* bad : malformedTexts ) {
+         std::vector<std::string> withBad( texts.begin(), texts.begin() + 21 );
+         withBad.emplace_back( bad );
+         withBad.insert( withBad.end(), texts.begin(), texts.begin() + 11 );
+         if ( !decodersAgree<Value>( withBad, scale, isa ) ) {
+            return isa;
+         }
+      }
+   }
+   return DecimalIsa::Best;
+}
+
+static void BM_DecodersAgree( benchmark::State& state ) {
+   static const char* const isaNames[] = { "scalar", "SSE4.1", "AVX2" };
+   std::string failed;
+   for ( auto _ : state ) {
+      for ( unsigned int scale : { 0U, 2U, 14U, 15U, 16U } ) {
+         DecimalIsa isa = firstDisagreeing<std::int64_t>( scale, 18 );
+         if ( isa != DecimalIsa::Best && failed.empty() ) {
+            failed = std::string( isaNames[ static_cast<int>( isa ) ] ) + " Decimal, scale " +
+                     std::to_string( scale );
+         }
+      }
+      for ( unsigned int scale : { 0U, 2U, 20U } ) {
+         DecimalIsa isa = firstDisagreeing<int128>( scale, 38 );
+         if ( isa != DecimalIsa::Best && failed.empty() ) {
+            failed = std::string( isaNames[ static_cast<int>( isa ) ] ) + " Decimal128, scale " +
+                     std::to_string( scale );
+         }
+      }
+   }
+   if ( !failed.empty() ) {
+      state.SkipWithError( ( "decodeDecimals() differs from parseDecimal(): " + failed ).c_str() );
+   }
+}
+BENCHMARK( BM_DecodersAgree )->Iterations( 1 );
+
+static void BM_FromCharsDouble( benchmark::State& state ) {
+   const ColumnarColumn& column = moneyColumn();
+   std::vector<double> out( batchRows );
+   for ( auto _ : state ) {
+      for ( size_t row = 0; row < batchRows; ++row ) {
+         std::string_view text = column.string( row );
+         std::from_chars( text.data(), text.data() + text.size(), out[ row ] );
+      }
+      benchmark::DoNotOptimize( out.data() );
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( batchRows ) );
+}
+BENCHMARK( BM_FromCharsDouble );
+
+static void BM_ParseDecimal( benchmark::State& state ) {
+   const ColumnarColumn& column = moneyColumn();
+   std::vector<Decimal> out( batchRows );
+   for ( auto _ : state ) {
+      for ( size_t row = 0; row < batchRows; ++row ) {
+         out[ row ].scale = moneyScale;
+         benchmark::DoNotOptimize( parseDecimal( column.string( row ), out[ row ] ) );
+      }
+      benchmark::DoNotOptimize( out.data() );
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( batchRows ) );
+}
+BENCHMARK( BM_ParseDecimal );
+
+static void BM_DecodeDecimals( benchmark::State& state ) {
+   auto isa = static_cast<DecimalIsa>( state.range( 0 ) );
+   if ( isa > bestDecimalIsa() ) {
+      state.SkipWithError( "not supported by this CPU" );
+      return;
+   }
+   const ColumnarColumn& column = moneyColumn();
+   std::vector<std::int64_t> out( batchRows );
+   for ( auto _ : state ) {
+      benchmark::DoNotOptimize( decodeDecimals( column, batchRows, moneyScale, out, isa ) );
+      benchmark::DoNotOptimize( out.data() );
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( batchRows ) );
+}
+BENCHMARK( BM_DecodeDecimals )
+    ->Arg( static_cast<int>( DecimalIsa::Scalar ) )
+    ->Arg( static_cast<int>( DecimalIsa::Sse41 ) )
+    ->Arg( static_cast<int>( DecimalIsa::Avx2 ) );
+
+static void BM_DecodeDecimals128( benchmark::State& state ) {
+   const ColumnarColumn& column = moneyColumn();
+   std::vector<int128> out( batchRows );
+   for ( auto _ : state ) {
+      benchmark::DoNotOptimize( decodeDecimals( column, batchRows, moneyScale, out ) );
+      benchmark::DoNotOptimize( out.data() );
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( batchRows ) );
+}
+BENCHMARK( BM_DecodeDecimals128 );
+
+static void BM_ToCharsDouble( benchmark::State& state ) {
+   double value = -1234567.89;
+   char text[ 32 ];
+   for ( auto _ : state ) {
+      benchmark::DoNotOptimize( std::to_chars( text, text + sizeof( text ), value ).ptr );
+      value += 0.01;
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_ToCharsDouble );
+
+static void BM_FormatDecimal( benchmark::State& state ) {
+   Decimal value;
+   value.scale = moneyScale;
+   value.unscaled = -123456789;
+   char text[ maxDecimalTextSize ];
+   for ( auto _ : state ) {
+      benchmark::DoNotOptimize( formatDecimal( text, value ) );
+      ++value.unscaled;
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_FormatDecimal );
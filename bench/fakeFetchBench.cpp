@@ -0,0 +1,121 @@
+/*
+    Rows per second through the fetch path with the fake client (fake/FakeClient.h) in place of a
+   server: mysql_stmt_fetch() into a BindsArray for a narrow and a wide table, RowCursor buffered
+   and unbuffered, ColumnarBatch::fill() and text protocol rows. Every run sees the same rows, so
+   the numbers only move when the library does.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "ColumnarBatch.h"
+#include "FakeClient.h"
+#include "RowCursor.h"
+#include "Statement.h"
+#include "benchRows.h"
+
+using namespace set_mysql_binds;
+
+static constexpr unsigned long long tableRows = 100000;
+
+static std::vector<Table> benchTables() {
+   Table narrow{ "narrow",
+                 { { "id", MYSQL_TYPE_LONG, NOT_NULL_FLAG, "int" },
+                   { "count", MYSQL_TYPE_LONGLONG, NOT_NULL_FLAG, "bigint" },
+                   { "amount", MYSQL_TYPE_DOUBLE, 0, "double" },
+                   { "name", MYSQL_TYPE_VAR_STRING, 0, "varchar(64)", 64 },
+                   { "created", MYSQL_TYPE_DATETIME, NOT_NULL_FLAG, "datetime" } } };
+   // The columns of benchRows.h's wide row
+   Table wide{ "wide", {} };
+   for ( size_t c = 0; c < bench::wideColumns; ++c ) {
+      Field field = narrow.fields[ c % narrow.fields.size() ];
+      field.name = bench::wideNames[ c ];
+      wide.fields.push_back( field );
+   }
+   return { narrow, wide };
+}
+
+struct FakeSession {
+   MYSQL* mysql;
+   FakeSession() : mysql( mysql_init( nullptr ) ) {
+      fake::setTables( benchTables(), tableRows );
+      mysql_real_connect( mysql, "fake", "", "", "", 0, nullptr, 0 );
+   }
+   ~FakeSession() { mysql_close( mysql ); }
+};
+
+static void BM_StatementFetch( benchmark::State& state ) {
+   FakeSession connection;
+   bool wide = state.range( 0 );
+   auto row = wide ? bench::makeWideOutput() : bench::makeNarrowOutput();
+   Statement statement( connection.mysql, wide ? "SELECT * FROM wide" : "SELECT * FROM narrow" );
+   statement.bindResults( row );
+   long rows = 0;
+   for ( auto _ : state ) {
+      statement.execute();
+      while ( statement.fetch() ) {
+         ++rows;
+      }
+      benchmark::DoNotOptimize( row.getBinds() );
+   }
+   state.SetItemsProcessed( rows );
+}
+BENCHMARK( BM_StatementFetch )->Arg( 0 )->Arg( 1 )->Unit( benchmark::kMillisecond );
+
+static void BM_RowCursor( benchmark::State& state ) {
+   FakeSession connection;
+   auto row = bench::makeNarrowOutput();
+   Statement statement( connection.mysql, "SELECT * FROM narrow" );
+   CursorOptions options;
+   options.mode = static_cast<FetchMode>( state.range( 0 ) );
+   long rows = 0;
+   for ( auto _ : state ) {
+      RowCursor cursor( statement, row, options );
+      for ( auto& r : cursor ) {
+         benchmark::DoNotOptimize( r.getBinds() );
+         ++rows;
+      }
+   }
+   state.SetItemsProcessed( rows );
+}
+BENCHMARK( BM_RowCursor )
+    ->Arg( static_cast<int>( FetchMode::Buffered ) )
+    ->Arg( static_cast<int>( FetchMode::Unbuffered ) )
+    ->Unit( benchmark::kMillisecond );
+
+static void BM_ColumnarFill( benchmark::State& state ) {
+   FakeSession connection;
+   auto row = bench::makeNarrowOutput();
+   Statement statement( connection.mysql, "SELECT * FROM narrow" );
+   statement.bindResults( row );
+   ColumnarBatch batch( row, static_cast<size_t>( state.range( 0 ) ) );
+   long rows = 0;
+   for ( auto _ : state ) {
+      statement.execute();
+      while ( size_t added = batch.fill( statement ) ) {
+         rows += static_cast<long>( added );
+         benchmark::DoNotOptimize( batch.column( 0 ).fixedValues.data() );
+         batch.clear();
+      }
+   }
+   state.SetItemsProcessed( rows );
+}
+BENCHMARK( BM_ColumnarFill )->Arg( 1024 )->Unit( benchmark::kMillisecond );
+
+static void BM_TextProtocolRows( benchmark::State& state ) {
+   FakeSession connection;
+   long rows = 0;
+   for ( auto _ : state ) {
+      mysql_query( connection.mysql, "SELECT * FROM narrow" );
+      MYSQL_RES* result = mysql_use_result( connection.mysql );
+      while ( MYSQL_ROW row = mysql_fetch_row( result ) ) {
+         benchmark::DoNotOptimize( row );
+         ++rows;
+      }
+      mysql_free_result( result );
+   }
+   state.SetItemsProcessed( rows );
+}
+BENCHMARK( BM_TextProtocolRows )->Unit( benchmark::kMillisecond );
@@ -0,0 +1,79 @@
+/*
+    Rows per second into the fake client (fake/FakeClient.h) for a backfill of a narrow table:
+   BatchInsert's multi-row prepared INSERTs against BulkLoader's LOAD DATA LOCAL INFILE stream.
+   The fake reads the stream in the client's 16 KiB packets and counts its rows, so the numbers
+   are those of the client side, formatting and handing over, with no server in the way.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <string>
+
+#include "BatchInsert.h"
+#include "BulkLoader.h"
+#include "FakeClient.h"
+#include "benchRows.h"
+
+using namespace set_mysql_binds;
+
+static constexpr unsigned long long loadRows = 100000;
+
+struct FakeSession {
+   MYSQL* mysql;
+   FakeSession() : mysql( mysql_init( nullptr ) ) {
+      mysql_real_connect( mysql, "fake", "", "", "", 0, nullptr, 0 );
+   }
+   ~FakeSession() { mysql_close( mysql ); }
+};
+
+static void setRow( BindsArray<InputCType>& row, unsigned long long r ) {
+   row[ 0 ] = static_cast<int>( r );
+   row[ 1 ] = static_cast<long long>( r * 31 );
+   row[ 2 ] = static_cast<double>( r ) / 4;
+   row[ 3 ] = "name\t" + std::to_string( r );
+   MYSQL_TIME created{};
+   created.year = 2024;
+   created.month = 1 + r % 12;
+   created.day = 1 + r % 28;
+   created.hour = r % 24;
+   created.time_type = MYSQL_TIMESTAMP_DATETIME;
+   row[ 4 ] = created;
+}
+
+static void BM_BatchInsert( benchmark::State& state ) {
+   FakeSession connection;
+   auto row = bench::makeNarrowInput();
+   long rows = 0;
+   for ( auto _ : state ) {
+      BatchInsert insert( connection.mysql, "narrow", row, 1000 );
+      for ( unsigned long long r = 0; r < loadRows; ++r ) {
+         setRow( row, r );
+         insert.addRow();
+      }
+      insert.flush();
+      rows += static_cast<long>( insert.rowsWritten() );
+   }
+   state.SetItemsProcessed( rows );
+}
+BENCHMARK( BM_BatchInsert )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+static void BM_BulkLoader( benchmark::State& state ) {
+   FakeSession connection;
+   auto row = bench::makeNarrowInput();
+   long rows = 0;
+   for ( auto _ : state ) {
+      BulkLoader loader( connection.mysql, "narrow", row, static_cast<size_t>( state.range( 0 ) ) );
+      for ( unsigned long long r = 0; r < loadRows; ++r ) {
+         setRow( row, r );
+         loader.addRow();
+      }
+      rows += static_cast<long>( loader.finish() );
+   }
+   state.SetItemsProcessed( rows );
+}
+BENCHMARK( BM_BulkLoader )
+    ->Arg( 64 * 1024 )
+    ->Arg( 1024 * 1024 )
+    ->Unit( benchmark::kMillisecond )
+    ->UseRealTime();
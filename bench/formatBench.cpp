@@ -0,0 +1,150 @@
+/*
+    Formatting a fetched row as text: the stream path (print_value as it was, setprecision and an
+   ostringstream per temporal value, std::endl per row), the same row through operator<< now that
+   print_value formats with TextFormat.hpp, and RowWriter appending CSV and TSV to a reused string.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "RowWriter.h"
+#include "benchRows.h"
+
+using namespace set_mysql_binds;
+
+static BindsArray<OutputCType> makeFetchedRow() {
+   auto row = bench::makeNarrowOutput( Bind<DATE>( "day" ) );
+   MYSQL_BIND* binds = row.getBinds();
+   *static_cast<int*>( binds[ 0 ].buffer ) = 123456;
+   *static_cast<long*>( binds[ 1 ].buffer ) = 9876543210L;
+   *static_cast<double*>( binds[ 2 ].buffer ) = 1234.5678;
+   std::memcpy( binds[ 3 ].buffer, "benchmark row", 13 );
+   *binds[ 3 ].length = 13;
+   MYSQL_TIME time{};
+   time.year = 2024;
+   time.month = 3;
+   time.day = 9;
+   time.hour = 17;
+   time.minute = 5;
+   time.second = 42;
+   *static_cast<MYSQL_TIME*>( binds[ 4 ].buffer ) = time;
+   *static_cast<MYSQL_TIME*>( binds[ 5 ].buffer ) = time;
+   return row;
+}
+
+// print_value before TextFormat.hpp
+static void legacyPrint( std::ostream& os, const MYSQL_BIND& bind ) {
+   os << std::boolalpha << std::setprecision( 15 );
+   switch ( bind.buffer_type ) {
+      case MYSQL_TYPE_LONG:
+         os << *static_cast<const int*>( bind.buffer );
+         break;
+      case MYSQL_TYPE_LONGLONG:
+         os << *static_cast<const long*>( bind.buffer );
+         break;
+      case MYSQL_TYPE_DOUBLE:
+         os << *static_cast<const double*>( bind.buffer );
+         break;
+      case MYSQL_TYPE_DATE:
+      case MYSQL_TYPE_DATETIME: {
+         const auto& value = *static_cast<const MYSQL_TIME*>( bind.buffer );
+         std::ostringstream _os;
+         _os << value.year << "-" << ( value.month > 9 ? "" : "0" ) << std::to_string( value.month )
+             << "-" << ( value.day > 9 ? "" : "0" ) << std::to_string( value.day ) << " "
+             << ( value.hour > 9 ? "" : "0" ) << std::to_string( value.hour ) << ":"
+             << ( value.minute > 9 ? "" : "0" ) << std::to_string( value.minute ) << ":"
+             << ( value.second > 9 ? "" : "0" ) << std::to_string( value.second );
+         os << std::move( _os.str() );
+         break;
+      }
+      default:
+         os.write( static_cast<const char*>( bind.buffer ),
+                   static_cast<std::streamsize>( *bind.length ) );
+   }
+}
+
+static void BM_LegacyStream( benchmark::State& state ) {
+   auto row = makeFetchedRow();
+   MYSQL_BIND* binds = row.getBinds();
+   std::ostringstream os;
+   for ( auto _ : state ) {
+      os.str( "" );
+      for ( size_t c = 0; c < row.getBindsSize(); ++c ) {
+         if ( c ) {
+            os << ',';
+         }
+         legacyPrint( os, binds[ c ] );
+      }
+      os << std::endl;
+      benchmark::DoNotOptimize( os );
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_LegacyStream );
+
+static void BM_PrintValueStream( benchmark::State& state ) {
+   auto row = makeFetchedRow();
+   std::ostringstream os;
+   for ( auto _ : state ) {
+      os.str( "" );
+      for ( size_t c = 0; c < row.fields.size(); ++c ) {
+         if ( c ) {
+            os << ',';
+         }
+         os << *row.fields[ c ];
+      }
+      os << '\n';
+      benchmark::DoNotOptimize( os );
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_PrintValueStream );
+
+static void BM_RowWriter( benchmark::State& state ) {
+   auto row = makeFetchedRow();
+   std::string out;
+   RowWriter writer( out, static_cast<RowFormat>( state.range( 0 ) ) );
+   for ( auto _ : state ) {
+      out.clear();
+      writer.writeRow( row );
+      benchmark::DoNotOptimize( out.data() );
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_RowWriter )
+    ->Arg( static_cast<int>( RowFormat::Csv ) )
+    ->Arg( static_cast<int>( RowFormat::Tsv ) );
+
+// A flush worth of rows into one string, as a bulk export writes them
+static void BM_RowWriterBulk( benchmark::State& state ) {
+   auto row = makeFetchedRow();
+   std::string out;
+   RowWriter writer( out );
+   const auto rows = state.range( 0 );
+   for ( auto _ : state ) {
+      out.clear();
+      for ( long i = 0; i < rows; ++i ) {
+         writer.writeRow( row );
+      }
+      benchmark::DoNotOptimize( out.data() );
+   }
+   state.SetItemsProcessed( state.iterations() * rows );
+   state.SetBytesProcessed( static_cast<long>( state.iterations() * out.size() ) );
+}
+BENCHMARK( BM_RowWriterBulk )->Arg( 1024 );
+
+static void BM_TimeToText( benchmark::State& state ) {
+   auto row = makeFetchedRow();
+   const MYSQL_BIND& created = row.getBinds()[ 4 ];
+   char text[ maxFixedTextSize ];
+   for ( auto _ : state ) {
+      benchmark::DoNotOptimize( bindToText( text, created ) );
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_TimeToText );
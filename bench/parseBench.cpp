@@ -0,0 +1,103 @@
+/*
+    Setting input binds from text fields, as a CSV feed is ingested: the stoX path operator= used
+   (a std::string per field, std::stol/stod, no temporal parsing) against setText() with
+   std::from_chars and parseTime() on string_views into the line.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchRows.h"
+
+using namespace set_mysql_binds;
+
+static std::vector<std::string_view> splitLine( std::string_view line ) {
+   std::vector<std::string_view> fields;
+   for ( size_t start = 0;; ) {
+      size_t comma = line.find( ',', start );
+      fields.push_back( line.substr( start, comma - start ) );
+      if ( comma == std::string_view::npos ) {
+         return fields;
+      }
+      start = comma + 1;
+   }
+}
+
+static const std::string numberLine = "123456,9876543210,1234.5678,benchmark row";
+
+// operator= as it was, a std::string for each field and exceptions on errors
+static void BM_StoXFields( benchmark::State& state ) {
+   auto row = bench::makeNarrowInput();
+   std::vector<std::string_view> fields = splitLine( numberLine );
+   for ( auto _ : state ) {
+      row[ 0 ].Value<INT>() = static_cast<int>( std::stol( std::string( fields[ 0 ] ) ) );
+      row[ 1 ].Value<BIGINT>() = std::stol( std::string( fields[ 1 ] ) );
+      row[ 2 ].Value<DOUBLE>() = std::stod( std::string( fields[ 2 ] ) );
+      row[ 3 ] = std::span<const unsigned char>(
+          reinterpret_cast<const unsigned char*>( fields[ 3 ].data() ), fields[ 3 ].size() );
+      benchmark::DoNotOptimize( row.getBinds() );
+   }
+   state.SetItemsProcessed( state.iterations() * 4 );
+}
+BENCHMARK( BM_StoXFields );
+
+static void BM_SetTextFields( benchmark::State& state ) {
+   auto row = bench::makeNarrowInput();
+   std::vector<std::string_view> fields = splitLine( numberLine );
+   for ( auto _ : state ) {
+      bool parsed = true;
+      for ( size_t c = 0; c < fields.size(); ++c ) {
+         parsed &= row[ c ].setText( fields[ c ] );
+      }
+      benchmark::DoNotOptimize( parsed );
+      benchmark::DoNotOptimize( row.getBinds() );
+   }
+   state.SetItemsProcessed( state.iterations() * 4 );
+}
+BENCHMARK( BM_SetTextFields );
+
+static void BM_SetTextDatetime( benchmark::State& state ) {
+   auto row = bench::makeNarrowInput();
+   std::string_view text = "2024-03-09 17:05:42.123456";
+   InputCType& created = row[ "created" ];
+   for ( auto _ : state ) {
+      benchmark::DoNotOptimize( created.setText( text ) );
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed( state.iterations() );
+   state.SetBytesProcessed( static_cast<long>( state.iterations() * text.size() ) );
+}
+BENCHMARK( BM_SetTextDatetime );
+
+// Rejected input costs a return value instead of a thrown exception
+static void BM_StolInvalid( benchmark::State& state ) {
+   std::string text = "12x";
+   for ( auto _ : state ) {
+      try {
+         size_t used;
+         long value = std::stol( text, &used );
+         if ( used != text.size() ) {
+            throw std::invalid_argument( text );
+         }
+         benchmark::DoNotOptimize( value );
+      } catch ( const std::invalid_argument& ) {
+         benchmark::ClobberMemory();
+      }
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_StolInvalid );
+
+static void BM_SetTextInvalid( benchmark::State& state ) {
+   auto row = bench::makeNarrowInput();
+   InputCType& id = row[ "id" ];
+   for ( auto _ : state ) {
+      benchmark::DoNotOptimize( id.setText( "12x" ) );
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_SetTextInvalid );
@@ -0,0 +1,87 @@
+/*
+    Writing and reading a row through the dynamic BindsArray (virtual operator=, hash map lookup
+   by name) against the same row in a StaticBindsArray.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "StaticBindsArray.hpp"
+#include "benchRows.h"
+
+using namespace set_mysql_binds;
+
+// The narrow row of benchRows.h
+using StaticRow = StaticBindsArray<InputCType, StaticBind<INT, "id">, StaticBind<BIGINT, "count">,
+                                   StaticBind<DOUBLE, "amount">, StaticBind<VARCHAR, "name", 64>,
+                                   StaticBind<DATETIME, "created">>;
+
+static const std::string rowName = "benchmark row";
+
+static void BM_DynamicSetByName( benchmark::State& state ) {
+   auto binds = bench::makeNarrowInput();
+   long i = 0;
+   for ( auto _ : state ) {
+      binds[ "id" ] = static_cast<long double>( i );
+      binds[ "count" ] = static_cast<long double>( i * 3 );
+      binds[ "amount" ] = static_cast<long double>( i ) * 0.5L;
+      binds[ "name" ] = rowName;
+      benchmark::DoNotOptimize( binds.getBinds() );
+      ++i;
+   }
+   state.SetItemsProcessed( i );
+}
+BENCHMARK( BM_DynamicSetByName );
+
+static void BM_DynamicSetByIndex( benchmark::State& state ) {
+   auto binds = bench::makeNarrowInput();
+   long i = 0;
+   for ( auto _ : state ) {
+      binds[ 0 ] = static_cast<long double>( i );
+      binds[ 1 ] = static_cast<long double>( i * 3 );
+      binds[ 2 ] = static_cast<long double>( i ) * 0.5L;
+      binds[ 3 ] = rowName;
+      benchmark::DoNotOptimize( binds.getBinds() );
+      ++i;
+   }
+   state.SetItemsProcessed( i );
+}
+BENCHMARK( BM_DynamicSetByIndex );
+
+static void BM_StaticSet( benchmark::State& state ) {
+   StaticRow row;
+   long i = 0;
+   for ( auto _ : state ) {
+      row.set<"id">( static_cast<int>( i ) );
+      row.set<"count">( i * 3 );
+      row.set<"amount">( static_cast<double>( i ) * 0.5 );
+      row.set<"name">( std::string_view( rowName ) );
+      benchmark::DoNotOptimize( row.getBinds() );
+      ++i;
+   }
+   state.SetItemsProcessed( i );
+}
+BENCHMARK( BM_StaticSet );
+
+static void BM_DynamicGetByName( benchmark::State& state ) {
+   auto binds = bench::makeNarrowInput();
+   for ( auto _ : state ) {
+      benchmark::DoNotOptimize( binds[ "id" ].Value<INT>() );
+      benchmark::DoNotOptimize( binds[ "count" ].Value<BIGINT>() );
+      benchmark::DoNotOptimize( binds[ "amount" ].Value<DOUBLE>() );
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_DynamicGetByName );
+
+static void BM_StaticGet( benchmark::State& state ) {
+   StaticRow row;
+   for ( auto _ : state ) {
+      benchmark::DoNotOptimize( row.get<"id">() );
+      benchmark::DoNotOptimize( row.get<"count">() );
+      benchmark::DoNotOptimize( row.get<"amount">() );
+   }
+   state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_StaticGet );
@@ -0,0 +1,133 @@
+/*
+    A column of fetched DATETIME values counted from the epoch, the way time series exports need
+   them: timegm() on a struct tm (what consumers did), the era based calendar math ArrowExport
+   used, and toEpochValues() over the whole column. The input direction converts epoch counts
+   back to MYSQL_TIME with gmtime_r() against toMysqlDateTime().
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <ctime>
+#include <random>
+#include <vector>
+
+#include "MysqlTime.h"
+
+using namespace set_mysql_binds;
+
+static constexpr size_t batchRows = 4096;
+
+// Microseconds from 1970 to 2038, DATETIME(6) values of a time series
+static const std::vector<std::int64_t>& epochValues() {
+   static const std::vector<std::int64_t> values = [] {
+      std::mt19937_64 rng( 11 );
+      std::vector<std::int64_t> v( batchRows );
+      for ( auto& value : v ) {
+         value = static_cast<std::int64_t>( rng() % 2145916800000000ULL );
+      }
+      return v;
+   }();
+   return values;
+}
+
+static const std::vector<MYSQL_TIME>& timeColumn() {
+   static const std::vector<MYSQL_TIME> times = [] {
+      std::vector<MYSQL_TIME> t( batchRows );
+      fromEpochValues( epochValues(), MYSQL_TYPE_DATETIME, t );
+      return t;
+   }();
+   return times;
+}
+
+static void BM_Timegm( benchmark::State& state ) {
+   const std::vector<MYSQL_TIME>& times = timeColumn();
+   std::vector<std::int64_t> out( batchRows );
+   for ( auto _ : state ) {
+      for ( size_t i = 0; i < batchRows; ++i ) {
+         const MYSQL_TIME& t = times[ i ];
+         std::tm tm{};
+         tm.tm_year = static_cast<int>( t.year ) - 1900;
+         tm.tm_mon = static_cast<int>( t.month ) - 1;
+         tm.tm_mday = static_cast<int>( t.day );
+         tm.tm_hour = static_cast<int>( t.hour );
+         tm.tm_min = static_cast<int>( t.minute );
+         tm.tm_sec = static_cast<int>( t.second );
+         out[ i ] = static_cast<std::int64_t>( timegm( &tm ) ) * 1000000 +
+                    static_cast<std::int64_t>( t.second_part );
+      }
+      benchmark::DoNotOptimize( out.data() );
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( batchRows ) );
+}
+BENCHMARK( BM_Timegm );
+
+// The conversion ArrowExport had, 64 bit eras with branches on the month and the era's sign
+static std::int64_t eraDaysFromCivil( std::int64_t year, unsigned int month, unsigned int day ) {
+   year -= month <= 2;
+   const std::int64_t era = ( year >= 0 ? year : year - 399 ) / 400;
+   const std::int64_t yearOfEra = year - era * 400;
+   const std::int64_t dayOfYear = ( 153 * ( month + ( month > 2 ? -3 : 9 ) ) + 2 ) / 5 + day - 1;
+   const std::int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+   return era * 146097 + dayOfEra - 719468;
+}
+
+static void BM_EraDaysFromCivil( benchmark::State& state ) {
+   const std::vector<MYSQL_TIME>& times = timeColumn();
+   std::vector<std::int64_t> out( batchRows );
+   for ( auto _ : state ) {
+      for ( size_t i = 0; i < batchRows; ++i ) {
+         const MYSQL_TIME& t = times[ i ];
+         out[ i ] = eraDaysFromCivil( t.year, t.month, t.day ) * 86400000000LL +
+                    clockDuration( t ).count();
+      }
+      benchmark::DoNotOptimize( out.data() );
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( batchRows ) );
+}
+BENCHMARK( BM_EraDaysFromCivil );
+
+static void BM_ToEpochValues( benchmark::State& state ) {
+   const std::vector<MYSQL_TIME>& times = timeColumn();
+   std::vector<std::int64_t> out( batchRows );
+   for ( auto _ : state ) {
+      toEpochValues( times, MYSQL_TYPE_DATETIME, out );
+      benchmark::DoNotOptimize( out.data() );
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( batchRows ) );
+}
+BENCHMARK( BM_ToEpochValues );
+
+static void BM_GmtimeR( benchmark::State& state ) {
+   const std::vector<std::int64_t>& values = epochValues();
+   std::vector<MYSQL_TIME> out( batchRows );
+   for ( auto _ : state ) {
+      for ( size_t i = 0; i < batchRows; ++i ) {
+         std::time_t seconds = static_cast<std::time_t>( values[ i ] / 1000000 );
+         std::tm tm;
+         gmtime_r( &seconds, &tm );
+         MYSQL_TIME& t = out[ i ];
+         t.year = static_cast<unsigned int>( tm.tm_year + 1900 );
+         t.month = static_cast<unsigned int>( tm.tm_mon + 1 );
+         t.day = static_cast<unsigned int>( tm.tm_mday );
+         t.hour = static_cast<unsigned int>( tm.tm_hour );
+         t.minute = static_cast<unsigned int>( tm.tm_min );
+         t.second = static_cast<unsigned int>( tm.tm_sec );
+         t.second_part = static_cast<unsigned long>( values[ i ] % 1000000 );
+      }
+      benchmark::DoNotOptimize( out.data() );
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( batchRows ) );
+}
+BENCHMARK( BM_GmtimeR );
+
+static void BM_FromEpochValues( benchmark::State& state ) {
+   const std::vector<std::int64_t>& values = epochValues();
+   std::vector<MYSQL_TIME> out( batchRows );
+   for ( auto _ : state ) {
+      fromEpochValues( values, MYSQL_TYPE_DATETIME, out );
+      benchmark::DoNotOptimize( out.data() );
+   }
+   state.SetItemsProcessed( state.iterations() * static_cast<long>( batchRows ) );
+}
+BENCHMARK( BM_FromEpochValues );
@@ -0,0 +1,1129 @@
+#include "FakeClient.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "SqlTypes/TextFormat.hpp"
+#include "SqlTypes/TextParse.hpp"
+
+namespace set_mysql_binds::fake {
+
+namespace {
+
+// The error numbers of mysqld_error.h and errmsg.h the fake reports
+constexpr unsigned int parseError = 1064;
+constexpr unsigned int badFieldError = 1054;
+constexpr unsigned int noSuchTableError = 1146;
+constexpr unsigned int commandsOutOfSync = 2014;
+constexpr unsigned int notPrepared = 2030;
+constexpr unsigned int paramsNotBound = 2031;
+constexpr unsigned int invalidParameterNumber = 2034;
+constexpr unsigned int noData = 2051;
+constexpr unsigned int noResultSet = 2053;
+constexpr unsigned int localInfileRejected = 2068;
+
+struct Schema {
+   std::vector<Table> tables;
+   unsigned long long rowCount = 1000;
+};
+
+std::mutex schemaMutex;
+std::shared_ptr<const Schema> schema = std::make_shared<const Schema>();
+
+std::shared_ptr<const Schema> currentSchema() {
+   std::lock_guard lock( schemaMutex );
+   return schema;
+}
+
+struct ErrorState {
+   unsigned int code = 0;
+   std::string message;
+
+   // Always true, for return fail( ... ) from the int and bool returning calls
+   bool fail( unsigned int _code, std::string _message ) {
+      code = _code;
+      message = std::move( _message );
+      return true;
+   }
+   void clear() {
+      code = 0;
+      message.clear();
+   }
+};
+
+// SQL parsing, just enough to find what a statement reads ****************************************
+
+struct Token {
+   enum class Kind { Word, Number, String, Symbol } kind;
+   std::string_view text;
+};
+
+bool isWordChar( char c ) {
+   return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || ( c >= '0' && c <= '9' ) ||
+          c == '_' || c == '$';
+}
+
+bool equalsWord( std::string_view a, std::string_view b ) {
+   return a.size() == b.size() &&
+          std::equal( a.begin(), a.end(), b.begin(), []( char x, char y ) {
+             return ( x >= 'A' && x <= 'Z' ? x + 32 : x ) == ( y >= 'A' && y <= 'Z' ? y + 32 : y );
+          } );
+}
+
+bool isWord( const Token& token, std::string_view word ) {
+   return token.kind == Token::Kind::Word && equalsWord( token.text, word );
+}
+
+bool isSymbol( const Token& token, char symbol ) {
+   return token.kind == Token::Kind::Symbol && token.text.front() == symbol;
+}
+
+std::vector<Token> tokenize( std::string_view sql ) {
+   std::vector<Token> tokens;
+   size_t i = 0;
+   while ( i < sql.size() ) {
+      char c = sql[ i ];
+      if ( c == ' ' || c == '\t' || c == '\n' || c == '\r' ) {
+         ++i;
+      } else if ( c == '#' || sql.substr( i, 3 ) == "-- " ) {
+         i = std::min( sql.find( '\n', i ), sql.size() );
+      } else if ( sql.substr( i, 2 ) == "/*" ) {
+         size_t end = sql.find( "*/", i + 2 );
+         i = end == std::string_view::npos ? sql.size() : end + 2;
+      } else if ( c == '\'' || c == '"' || c == '`' ) {
+         size_t start = ++i;
+         while ( i < sql.size() && sql[ i ] != c ) {
+            i += sql[ i ] == '\\' && c != '`' ? 2 : 1;
+         }
+         i = std::min( i, sql.size() );
+         tokens.push_back( { c == '`' ? Token::Kind::Word : Token::Kind::String,
+                             sql.substr( start, i - start ) } );
+         ++i;
+      } else if ( c >= '0' && c <= '9' ) {
+         size_t start = i;
+         while ( i < sql.size() && ( isWordChar( sql[ i ] ) || sql[ i ] == '.' ) ) {
+            ++i;
+         }
+         tokens.push_back( { Token::Kind::Number, sql.substr( start, i - start ) } );
+      } else if ( isWordChar( c ) ) {
+         size_t start = i;
+         while ( i < sql.size() && isWordChar( sql[ i ] ) ) {
+            ++i;
+         }
+         tokens.push_back( { Token::Kind::Word, sql.substr( start, i - start ) } );
+      } else {
+         tokens.push_back( { Token::Kind::Symbol, sql.substr( i++, 1 ) } );
+      }
+   }
+   return tokens;
+}
+
+struct Query {
+   bool isSelect = false;
+   bool isInsert = false;
+   bool isLoadLocal = false;  // LOAD DATA LOCAL INFILE, its file name in localFile
+   std::string localFile;
+   const Table* table = nullptr;
+   std::vector<const Field*> columns;
+   unsigned long long rows = 0;  // rows a SELECT returns
+   unsigned long paramCount = 0;
+   unsigned long long affectedRows = 0;  // of any other statement
+};
+
+// The name ending a possibly qualified name (db.table, table.column) starting at tokens[ i ]
+std::string_view qualifiedName( const std::vector<Token>& tokens, size_t& i ) {
+   std::string_view name = tokens[ i++ ].text;
+   while ( i + 1 < tokens.size() && isSymbol( tokens[ i ], '.' ) &&
+           tokens[ i + 1 ].kind == Token::Kind::Word ) {
+      name = tokens[ i + 1 ].text;
+      i += 2;
+   }
+   return name;
+}
+
+unsigned long long parseCount( const Token& token ) {
+   unsigned long long count = 0;
+   parseNumber( token.text, count );
+   return count;
+}
+
+bool parseSelect( const std::vector<Token>& tokens, const Schema& source, Query& query,
+                  ErrorState& error ) {
+   query.isSelect = true;
+   std::vector<std::string_view> names;
+   bool all = false;
+   size_t i = 1;
+   while ( i < tokens.size() && !isWord( tokens[ i ], "from" ) ) {
+      if ( isSymbol( tokens[ i ], '*' ) ) {
+         all = true;
+         ++i;
+      } else if ( tokens[ i ].kind == Token::Kind::Word ) {
+         names.push_back( qualifiedName( tokens, i ) );
+         if ( i < tokens.size() && isWord( tokens[ i ], "as" ) ) {
+            i += 2;
+         } else if ( i < tokens.size() && tokens[ i ].kind == Token::Kind::Word &&
+                     !isWord( tokens[ i ], "from" ) ) {
+            ++i;  // alias
+         }
+      } else {
+         return error.fail( parseError, "The fake client only selects plain columns, near '" +
+                                            std::string( tokens[ i ].text ) + "'" );
+      }
+      if ( i < tokens.size() && isSymbol( tokens[ i ], ',' ) ) {
+         ++i;
+      } else if ( i < tokens.size() && !isWord( tokens[ i ], "from" ) ) {
+         return error.fail( parseError, "The fake client only selects plain columns, near '" +
+                                            std::string( tokens[ i ].text ) + "'" );
+      }
+   }
+   if ( i + 1 >= tokens.size() || tokens[ i + 1 ].kind != Token::Kind::Word ) {
+      return error.fail( parseError, "The fake client needs SELECT ... FROM table" );
+   }
+   ++i;
+   std::string_view tableName = qualifiedName( tokens, i );
+   auto table = std::find_if( source.tables.begin(), source.tables.end(),
+                              [ & ]( const Table& t ) { return equalsWord( t.name, tableName ); } );
+   if ( table == source.tables.end() ) {
+      return error.fail( noSuchTableError,
+                         "Table '" + std::string( tableName ) + "' doesn't exist" );
+   }
+   query.table = &*table;
+
+   if ( all ) {
+      for ( const Field& field : table->fields ) {
+         query.columns.push_back( &field );
+      }
+   }
+   for ( std::string_view name : names ) {
+      auto field = std::find_if( table->fields.begin(), table->fields.end(),
+                                 [ & ]( const Field& f ) { return equalsWord( f.name, name ); } );
+      if ( field == table->fields.end() ) {
+         return error.fail( badFieldError,
+                            "Unknown column '" + std::string( name ) + "' in 'field list'" );
+      }
+      query.columns.push_back( &*field );
+   }
+
+   // LIMIT count, LIMIT offset, count and LIMIT count OFFSET offset
+   query.rows = source.rowCount;
+   for ( ; i < tokens.size(); ++i ) {
+      if ( isWord( tokens[ i ], "limit" ) && i + 1 < tokens.size() ) {
+         unsigned long long count = parseCount( tokens[ i + 1 ] );
+         unsigned long long offset = 0;
+         if ( i + 3 < tokens.size() && isSymbol( tokens[ i + 2 ], ',' ) ) {
+            offset = count;
+            count = parseCount( tokens[ i + 3 ] );
+         } else if ( i + 3 < tokens.size() && isWord( tokens[ i + 2 ], "offset" ) ) {
+            offset = parseCount( tokens[ i + 3 ] );
+         }
+         query.rows = offset < query.rows ? std::min( count, query.rows - offset ) : 0;
+         break;
+      }
+   }
+   return false;
+}
+
+// Returns true, with error set, when sql cannot be run
+bool parseQuery( std::string_view sql, const Schema& source, Query& query, ErrorState& error ) {
+   query = Query{};
+   std::vector<Token> tokens = tokenize( sql );
+   if ( tokens.empty() ) {
+      return error.fail( parseError, "Query was empty" );
+   }
+   query.paramCount = static_cast<unsigned long>( std::count_if(
+       tokens.begin(), tokens.end(), []( const Token& t ) { return isSymbol( t, '?' ); } ) );
+   if ( isWord( tokens[ 0 ], "select" ) ) {
+      return parseSelect( tokens, source, query, error );
+   }
+
+   if ( tokens.size() > 4 && isWord( tokens[ 0 ], "load" ) && isWord( tokens[ 1 ], "data" ) &&
+        isWord( tokens[ 2 ], "local" ) && isWord( tokens[ 3 ], "infile" ) &&
+        tokens[ 4 ].kind == Token::Kind::String ) {
+      query.isLoadLocal = true;
+      query.localFile = tokens[ 4 ].text;
+      return false;
+   }
+
+   query.affectedRows = 1;
+   if ( isWord( tokens[ 0 ], "insert" ) || isWord( tokens[ 0 ], "replace" ) ) {
+      query.isInsert = true;
+      auto values = std::find_if( tokens.begin(), tokens.end(), []( const Token& t ) {
+         return isWord( t, "values" ) || isWord( t, "value" );
+      } );
+      if ( values != tokens.end() ) {
+         // one row per parenthesized group after VALUES
+         unsigned long long rows = 0;
+         int depth = 0;
+         for ( auto t = values + 1; t != tokens.end(); ++t ) {
+            if ( isSymbol( *t, '(' ) && depth++ == 0 ) {
+               ++rows;
+            } else if ( isSymbol( *t, ')' ) ) {
+               --depth;
+            }
+         }
+         query.affectedRows = std::max<unsigned long long>( rows, 1 );
+      }
+   }
+   return false;
+}
+
+// Values ******************************************************************************************
+
+struct Value {
+   enum class Kind { Null, Signed, Unsigned, Real, Time, Text } kind = Kind::Null;
+   long long integer = 0;
+   unsigned long long uinteger = 0;
+   double real = 0;
+   MYSQL_TIME time{};
+   char text[ 96 ];
+   size_t length = 0;
+
+   std::string_view view() const { return { text, length }; }
+};
+
+template <typename Signed>
+void setInteger( Value& value, unsigned long long n, bool isUnsigned ) {
+   if ( isUnsigned ) {
+      value.kind = Value::Kind::Unsigned;
+      value.uinteger = static_cast<std::make_unsigned_t<Signed>>( n );
+   } else {
+      value.kind = Value::Kind::Signed;
+      value.integer = static_cast<Signed>( n );
+   }
+}
+
+void appendText( Value& value, std::string_view text ) {
+   size_t copied = std::min( text.size(), sizeof( value.text ) - value.length );
+   std::memcpy( value.text + value.length, text.data(), copied );
+   value.length += copied;
+}
+
+void appendNumber( Value& value, unsigned long long n, size_t width = 0 ) {
+   char digits[ 24 ];
+   char* end = std::to_chars( digits, digits + sizeof( digits ), n ).ptr;
+   for ( size_t i = static_cast<size_t>( end - digits ); i < width; ++i ) {
+      appendText( value, "0" );
+   }
+   appendText( value, { digits, static_cast<size_t>( end - digits ) } );
+}
+
+unsigned long long powerOfTen( unsigned int digits ) {
+   unsigned long long power = 1;
+   for ( unsigned int i = 0; i < std::min( digits, 18U ); ++i ) {
+      power *= 10;
+   }
+   return power;
+}
+
+void generate( const Field& field, size_t column, unsigned long long row, Value& value ) {
+   value.length = 0;
+   if ( !( field.flags & NOT_NULL_FLAG ) && row % 16 == 15 ) {
+      value.kind = Value::Kind::Null;
+      return;
+   }
+   const unsigned long long n = row * 31 + column;
+   const bool isUnsigned = field.flags & UNSIGNED_FLAG;
+   switch ( field.type ) {
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_BOOL:
+         return setInteger<signed char>( value, n, isUnsigned );
+      case MYSQL_TYPE_SHORT:
+         return setInteger<short>( value, n, isUnsigned );
+      case MYSQL_TYPE_INT24:
+         return setInteger<int>( value, n % ( 1U << 23 ), isUnsigned );
+      case MYSQL_TYPE_LONG:
+         return setInteger<int>( value, n, isUnsigned );
+      case MYSQL_TYPE_LONGLONG:
+         return setInteger<long long>( value, n, isUnsigned );
+      case MYSQL_TYPE_YEAR:
+         return setInteger<short>( value, 1901 + row % 255, true );
+      case MYSQL_TYPE_BIT: {
+         unsigned int bits = std::clamp( field.numericPrecision, 1U, 64U );
+         return setInteger<long long>(
+             value, bits == 64 ? n : n & ( ( 1ULL << bits ) - 1 ), true );
+      }
+      case MYSQL_TYPE_FLOAT:
+      case MYSQL_TYPE_DOUBLE:
+         value.kind = Value::Kind::Real;
+         value.real = static_cast<double>( row ) / 2 + static_cast<double>( column );
+         return;
+      case MYSQL_TYPE_DATE:
+      case MYSQL_TYPE_DATETIME:
+      case MYSQL_TYPE_TIMESTAMP:
+      case MYSQL_TYPE_TIME: {
+         value.kind = Value::Kind::Time;
+         MYSQL_TIME& time = value.time;
+         time = MYSQL_TIME{};
+         if ( field.type == MYSQL_TYPE_TIME ) {
+            time.time_type = MYSQL_TIMESTAMP_TIME;
+            time.hour = static_cast<unsigned int>( row % 839 );
+         } else {
+            time.time_type = field.type == MYSQL_TYPE_DATE ? MYSQL_TIMESTAMP_DATE
+                                                           : MYSQL_TIMESTAMP_DATETIME;
+            time.year = static_cast<unsigned int>( 2000 + row / 336 % 100 );
+            time.month = static_cast<unsigned int>( 1 + row / 28 % 12 );
+            time.day = static_cast<unsigned int>( 1 + row % 28 );
+            time.hour = field.type == MYSQL_TYPE_DATE ? 0 : static_cast<unsigned int>( row % 24 );
+         }
+         if ( field.type != MYSQL_TYPE_DATE ) {
+            time.minute = static_cast<unsigned int>( row * 7 % 60 );
+            time.second = static_cast<unsigned int>( row * 13 % 60 );
+         }
+         return;
+      }
+      case MYSQL_TYPE_NEWDECIMAL:
+      case MYSQL_TYPE_DECIMAL: {
+         value.kind = Value::Kind::Text;
+         unsigned int precision = field.numericPrecision ? field.numericPrecision : 10;
+         unsigned int scale = std::min( field.numericScale, precision );
+         appendNumber( value, row % powerOfTen( precision - scale ) );
+         if ( scale ) {
+            appendText( value, "." );
+            appendNumber( value, row * 7 % powerOfTen( scale ), std::min( scale, 18U ) );
+         }
+         return;
+      }
+      case MYSQL_TYPE_JSON:
+         value.kind = Value::Kind::Text;
+         appendText( value, "{\"row\": " );
+         appendNumber( value, row );
+         appendText( value, "}" );
+         return;
+      default:
+         value.kind = Value::Kind::Text;
+         appendText( value, std::string_view( field.name ).substr( 0, 40 ) );
+         appendText( value, "-" );
+         appendNumber( value, row );
+         if ( field.maxLength ) {
+            value.length = std::min<size_t>( value.length, field.maxLength );
+         }
+         return;
+   }
+}
+
+// The text the server sends for value, scratch holds maxFixedTextSize chars
+std::string_view valueText( const Value& value, enum_field_types type, char* scratch ) {
+   char* end = scratch;
+   switch ( value.kind ) {
+      case Value::Kind::Signed:
+         end = formatNumber( scratch, value.integer );
+         break;
+      case Value::Kind::Unsigned:
+         end = formatNumber( scratch, value.uinteger );
+         break;
+      case Value::Kind::Real:
+         end = type == MYSQL_TYPE_FLOAT ? formatNumber( scratch, static_cast<float>( value.real ) )
+                                        : formatNumber( scratch, value.real );
+         break;
+      case Value::Kind::Time:
+         end = formatTime( scratch, value.time, type );
+         break;
+      case Value::Kind::Text:
+         return value.view();
+      case Value::Kind::Null:
+         break;
+   }
+   return { scratch, static_cast<size_t>( end - scratch ) };
+}
+
+// A temporal value read as a number, 20240309 or 20240309170542 or 170542
+long long timeNumber( const MYSQL_TIME& time ) {
+   long long date = time.year * 10000LL + time.month * 100LL + time.day;
+   long long clock = time.hour * 10000LL + time.minute * 100LL + time.second;
+   switch ( time.time_type ) {
+      case MYSQL_TIMESTAMP_DATE:
+         return date;
+      case MYSQL_TIMESTAMP_TIME:
+         return time.neg ? -clock : clock;
+      default:
+         return date * 1000000 + clock;
+   }
+}
+
+template <typename T>
+T valueNumber( const Value& value ) {
+   switch ( value.kind ) {
+      case Value::Kind::Signed:
+         return static_cast<T>( value.integer );
+      case Value::Kind::Unsigned:
+         return static_cast<T>( value.uinteger );
+      case Value::Kind::Real:
+         return static_cast<T>( value.real );
+      case Value::Kind::Time:
+         return static_cast<T>( timeNumber( value.time ) );
+      case Value::Kind::Text: {
+         double number = 0;
+         parseNumber( value.view(), number );
+         return static_cast<T>( number );
+      }
+      default:
+         return T{};
+   }
+}
+
+template <typename Signed>
+unsigned long writeInteger( MYSQL_BIND& bind, const Value& value ) {
+   if ( bind.is_unsigned ) {
+      auto number = static_cast<std::make_unsigned_t<Signed>>(
+          value.kind == Value::Kind::Real ? valueNumber<long long>( value )
+                                          : valueNumber<unsigned long long>( value ) );
+      std::memcpy( bind.buffer, &number, sizeof( number ) );
+   } else {
+      auto number = static_cast<Signed>( valueNumber<long long>( value ) );
+      std::memcpy( bind.buffer, &number, sizeof( number ) );
+   }
+   return sizeof( Signed );
+}
+
+// Writes value into bind the way the client library converts a column of type to the bind's
+// buffer_type, char[] values from offset on. Returns true when a char[] value did not fit.
+bool writeBind( MYSQL_BIND& bind, const Value& value, enum_field_types type,
+                unsigned long offset = 0 ) {
+   bool isNull = value.kind == Value::Kind::Null;
+   if ( bind.is_null ) {
+      *bind.is_null = isNull;
+   }
+   if ( bind.error ) {
+      *bind.error = false;
+   }
+   if ( isNull || bind.buffer_type == MYSQL_TYPE_NULL ) {
+      return false;
+   }
+
+   unsigned long length = 0;
+   bool truncated = false;
+   switch ( bind.buffer_type ) {
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_BOOL:
+         length = writeInteger<signed char>( bind, value );
+         break;
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_YEAR:
+         length = writeInteger<short>( bind, value );
+         break;
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_INT24:
+         length = writeInteger<int>( bind, value );
+         break;
+      case MYSQL_TYPE_LONGLONG:
+      case MYSQL_TYPE_BIT:
+         length = writeInteger<long long>( bind, value );
+         break;
+      case MYSQL_TYPE_FLOAT: {
+         auto number = valueNumber<float>( value );
+         std::memcpy( bind.buffer, &number, sizeof( number ) );
+         length = sizeof( number );
+         break;
+      }
+      case MYSQL_TYPE_DOUBLE: {
+         auto number = valueNumber<double>( value );
+         std::memcpy( bind.buffer, &number, sizeof( number ) );
+         length = sizeof( number );
+         break;
+      }
+      case MYSQL_TYPE_DATE:
+      case MYSQL_TYPE_TIME:
+      case MYSQL_TYPE_DATETIME:
+      case MYSQL_TYPE_TIMESTAMP: {
+         MYSQL_TIME time{};
+         if ( value.kind == Value::Kind::Time ) {
+            time = value.time;
+         } else if ( value.kind == Value::Kind::Text ) {
+            parseTime( value.view(), time );
+         }
+         std::memcpy( bind.buffer, &time, sizeof( time ) );
+         length = sizeof( time );
+         break;
+      }
+      default: {
+         char scratch[ maxFixedTextSize ];
+         std::string_view text = valueText( value, type, scratch );
+         size_t available = offset < text.size() ? text.size() - offset : 0;
+         size_t copied = std::min<size_t>( available, bind.buffer_length );
+         if ( copied ) {
+            std::memcpy( bind.buffer, text.data() + offset, copied );
+         }
+         if ( copied < bind.buffer_length ) {
+            static_cast<char*>( bind.buffer )[ copied ] = '\0';
+         }
+         length = static_cast<unsigned long>( text.size() );
+         truncated = copied < available;
+         break;
+      }
+   }
+   if ( bind.length ) {
+      *bind.length = length;
+   }
+   if ( truncated && bind.error ) {
+      *bind.error = true;
+   }
+   return truncated;
+}
+
+// Handles ****************************************************************************************
+
+MYSQL_FIELD makeField( const Table& table, const Field& field ) {
+   static char empty[] = "";
+   MYSQL_FIELD result{};
+   result.name = result.org_name = const_cast<char*>( field.name.c_str() );
+   result.name_length = static_cast<unsigned int>( field.name.size() );
+   result.table = result.org_table = const_cast<char*>( table.name.c_str() );
+   result.db = result.catalog = result.def = empty;
+   result.type = field.type;
+   result.flags = static_cast<unsigned int>( field.flags );
+   result.decimals = field.numericScale;
+   result.length = static_cast<unsigned long>(
+       field.maxLength ? field.maxLength : std::max( field.numericPrecision, 1U ) );
+   result.charsetnr = isCharArray( field.type ) && !( field.flags & BINARY_FLAG ) ? 255 : 63;
+   return result;
+}
+
+struct FakeResult : MYSQL_RES {
+   std::shared_ptr<const Schema> source;
+   Query query;
+   unsigned long long nextRow = 0;
+   std::vector<MYSQL_FIELD> fieldList;
+   std::vector<Value> values;
+   std::vector<std::string> texts;
+   std::vector<char*> row;
+   std::vector<unsigned long> lengths;
+
+   FakeResult( std::shared_ptr<const Schema> _source, const Query& _query, bool withRows )
+       : MYSQL_RES{}, source( std::move( _source ) ), query( _query ) {
+      for ( const Field* field : query.columns ) {
+         fieldList.push_back( makeField( *query.table, *field ) );
+      }
+      if ( !withRows ) {
+         query.rows = 0;
+      }
+      row_count = query.rows;
+      fields = fieldList.data();
+      values.resize( query.columns.size() );
+      texts.resize( query.columns.size() );
+      row.resize( query.columns.size() );
+      lengths.resize( query.columns.size() );
+   }
+
+   MYSQL_ROW fetch() {
+      if ( nextRow >= query.rows ) {
+         return nullptr;
+      }
+      for ( size_t c = 0; c < query.columns.size(); ++c ) {
+         generate( *query.columns[ c ], c, nextRow, values[ c ] );
+         if ( values[ c ].kind == Value::Kind::Null ) {
+            row[ c ] = nullptr;
+            lengths[ c ] = 0;
+            continue;
+         }
+         char scratch[ maxFixedTextSize ];
+         texts[ c ].assign( valueText( values[ c ], query.columns[ c ]->type, scratch ) );
+         row[ c ] = texts[ c ].data();
+         lengths[ c ] = static_cast<unsigned long>( texts[ c ].size() );
+      }
+      ++nextRow;
+      return row.data();
+   }
+};
+
+struct FakeConnection {
+   ErrorState error;
+   bool allocated = false;
+   bool hasResult = false;  // a SELECT ran and its result was not taken yet
+   std::shared_ptr<const Schema> source;
+   Query query;
+   unsigned int fieldCount = 0;
+   unsigned long long affectedRows = 0;
+   unsigned long long nextInsertId = 1;
+
+   // mysql_set_local_infile_handler(), no handler (the client's default reading files) when null
+   int ( *infileInit )( void**, const char*, void* ) = nullptr;
+   int ( *infileRead )( void*, char*, unsigned int ) = nullptr;
+   void ( *infileEnd )( void* ) = nullptr;
+   int ( *infileError )( void*, char*, unsigned int ) = nullptr;
+   void* infileUserdata = nullptr;
+};
+
+FakeConnection& connectionOf( MYSQL* mysql ) {
+   return *static_cast<FakeConnection*>( mysql->extension );
+}
+
+// Reads the stream of a LOAD DATA LOCAL INFILE through the handler in packets of the client's
+// default size and counts its lines as the rows loaded. Returns true, with error set, on failure.
+bool loadLocalInfile( FakeConnection& connection ) {
+   if ( !connection.infileInit ) {
+      return connection.error.fail(
+          localInfileRejected, "LOAD DATA LOCAL INFILE without a handler is not emulated" );
+   }
+   void* stream = nullptr;
+   unsigned long long lines = 0;
+   bool failed = connection.infileInit( &stream, connection.query.localFile.c_str(),
+                                        connection.infileUserdata ) != 0;
+   if ( !failed ) {
+      char packet[ 16384 ];
+      int length;
+      while ( ( length = connection.infileRead( stream, packet, sizeof( packet ) ) ) > 0 ) {
+         lines += static_cast<unsigned long long>( std::count( packet, packet + length, '\n' ) );
+      }
+      failed = length < 0;
+   }
+   if ( failed ) {
+      char message[ 512 ] = "";
+      unsigned int code = static_cast<unsigned int>(
+          connection.infileError( stream, message, sizeof( message ) ) );
+      connection.infileEnd( stream );
+      return connection.error.fail( code, message );
+   }
+   connection.infileEnd( stream );
+   connection.affectedRows = lines;
+   return false;
+}
+
+struct FakeStatement : MYSQL_STMT {
+   ErrorState error;
+   FakeConnection* connection;
+   std::shared_ptr<const Schema> source;
+   Query query;
+   bool prepared = false;
+   bool executed = false;
+   bool paramsBound = false;
+   bool stored = false;
+   bool hasRow = false;
+   unsigned long long nextRow = 0;
+   unsigned long long affectedRows = 0;
+   unsigned long long insertId = 0;
+   unsigned long cursorType = CURSOR_TYPE_NO_CURSOR;
+   unsigned long prefetchRows = 1;
+   bool updateMaxLength = false;
+   std::vector<MYSQL_BIND> params;
+   std::vector<MYSQL_BIND> results;
+   std::vector<Value> values;
+
+   FakeStatement( MYSQL* _mysql )
+       : MYSQL_STMT{}, connection( &connectionOf( _mysql ) ) {
+      mysql = _mysql;
+   }
+};
+
+FakeStatement& statementOf( MYSQL_STMT* stmt ) { return *static_cast<FakeStatement*>( stmt ); }
+
+}  // namespace
+
+void setTables( std::vector<Table> tables, unsigned long long rowCount ) {
+   auto next = std::make_shared<Schema>();
+   next->tables = std::move( tables );
+   next->rowCount = rowCount;
+   std::lock_guard lock( schemaMutex );
+   schema = std::move( next );
+}
+
+void setRowCount( unsigned long long rowCount ) {
+   std::lock_guard lock( schemaMutex );
+   auto next = std::make_shared<Schema>( *schema );
+   next->rowCount = rowCount;
+   schema = std::move( next );
+}
+
+}  // namespace set_mysql_binds::fake
+
+using namespace set_mysql_binds::fake;
+
+extern "C" {
+
+// Library and connections ************************************************************************
+
+int mysql_server_init( int, char**, char** ) { return 0; }
+void mysql_server_end( void ) {}
+bool mysql_thread_init( void ) { return false; }
+void mysql_thread_end( void ) {}
+
+MYSQL* mysql_init( MYSQL* mysql ) {
+   bool allocated = !mysql;
+   if ( allocated ) {
+      mysql = new MYSQL;
+   }
+   std::memset( static_cast<void*>( mysql ), 0, sizeof( *mysql ) );
+   mysql->net.fd = -1;
+   auto* connection = new FakeConnection;
+   connection->allocated = allocated;
+   mysql->extension = connection;
+   return mysql;
+}
+
+MYSQL* mysql_real_connect( MYSQL* mysql, const char*, const char*, const char*, const char*,
+                           unsigned int, const char*, unsigned long ) {
+   connectionOf( mysql ).error.clear();
+   return mysql;
+}
+
+void mysql_close( MYSQL* mysql ) {
+   if ( !mysql ) {
+      return;
+   }
+   auto* connection = &connectionOf( mysql );
+   bool allocated = connection->allocated;
+   delete connection;
+   mysql->extension = nullptr;
+   if ( allocated ) {
+      delete mysql;
+   }
+}
+
+int mysql_options( MYSQL*, enum mysql_option, const void* ) { return 0; }
+int mysql_ping( MYSQL* ) { return 0; }
+const char* mysql_error( MYSQL* mysql ) { return connectionOf( mysql ).error.message.c_str(); }
+unsigned int mysql_errno( MYSQL* mysql ) { return connectionOf( mysql ).error.code; }
+unsigned int mysql_field_count( MYSQL* mysql ) { return connectionOf( mysql ).fieldCount; }
+uint64_t mysql_affected_rows( MYSQL* mysql ) { return connectionOf( mysql ).affectedRows; }
+
+void mysql_set_local_infile_handler( MYSQL* mysql,
+                                     int ( *local_infile_init )( void**, const char*, void* ),
+                                     int ( *local_infile_read )( void*, char*, unsigned int ),
+                                     void ( *local_infile_end )( void* ),
+                                     int ( *local_infile_error )( void*, char*, unsigned int ),
+                                     void* userdata ) {
+   FakeConnection& connection = connectionOf( mysql );
+   connection.infileInit = local_infile_init;
+   connection.infileRead = local_infile_read;
+   connection.infileEnd = local_infile_end;
+   connection.infileError = local_infile_error;
+   connection.infileUserdata = userdata;
+}
+
+void mysql_set_local_infile_default( MYSQL* mysql ) {
+   mysql_set_local_infile_handler( mysql, nullptr, nullptr, nullptr, nullptr, nullptr );
+}
+
+unsigned long mysql_real_escape_string( MYSQL*, char* to, const char* from,
+                                        unsigned long length ) {
+   char* out = to;
+   for ( unsigned long i = 0; i < length; ++i ) {
+      char escaped = 0;
+      switch ( from[ i ] ) {
+         case '\0':
+            escaped = '0';
+            break;
+         case '\n':
+            escaped = 'n';
+            break;
+         case '\r':
+            escaped = 'r';
+            break;
+         case '\032':
+            escaped = 'Z';
+            break;
+         case '\\':
+         case '\'':
+         case '"':
+            escaped = from[ i ];
+            break;
+      }
+      if ( escaped ) {
+         *out++ = '\\';
+         *out++ = escaped;
+      } else {
+         *out++ = from[ i ];
+      }
+   }
+   *out = '\0';
+   return static_cast<unsigned long>( out - to );
+}
+
+// Text protocol **********************************************************************************
+
+int mysql_real_query( MYSQL* mysql, const char* q, unsigned long length ) {
+   FakeConnection& connection = connectionOf( mysql );
+   if ( connection.hasResult ) {
+      return connection.error.fail( commandsOutOfSync,
+                                    "Commands out of sync; you can't run this command now" );
+   }
+   connection.error.clear();
+   connection.source = currentSchema();
+   if ( parseQuery( { q, length }, *connection.source, connection.query, connection.error ) ) {
+      return 1;
+   }
+   if ( connection.query.isLoadLocal ) {
+      connection.fieldCount = 0;
+      return loadLocalInfile( connection );
+   }
+   if ( connection.query.isSelect ) {
+      connection.hasResult = true;
+      connection.fieldCount = static_cast<unsigned int>( connection.query.columns.size() );
+      connection.affectedRows = ~0ULL;
+   } else {
+      connection.fieldCount = 0;
+      connection.affectedRows = connection.query.affectedRows;
+      if ( connection.query.isInsert ) {
+         connection.nextInsertId += connection.query.affectedRows;
+      }
+   }
+   return 0;
+}
+
+int mysql_query( MYSQL* mysql, const char* q ) {
+   return mysql_real_query( mysql, q, static_cast<unsigned long>( std::strlen( q ) ) );
+}
+
+static MYSQL_RES* takeResult( MYSQL* mysql ) {
+   FakeConnection& connection = connectionOf( mysql );
+   if ( !connection.hasResult ) {
+      return nullptr;
+   }
+   connection.hasResult = false;
+   connection.affectedRows = connection.query.rows;
+   return new FakeResult( connection.source, connection.query, true );
+}
+
+MYSQL_RES* mysql_store_result( MYSQL* mysql ) { return takeResult( mysql ); }
+MYSQL_RES* mysql_use_result( MYSQL* mysql ) { return takeResult( mysql ); }
+
+MYSQL_ROW mysql_fetch_row( MYSQL_RES* result ) {
+   return static_cast<FakeResult*>( result )->fetch();
+}
+
+unsigned long* mysql_fetch_lengths( MYSQL_RES* result ) {
+   return static_cast<FakeResult*>( result )->lengths.data();
+}
+
+uint64_t mysql_num_rows( MYSQL_RES* result ) { return result->row_count; }
+
+unsigned int mysql_num_fields( MYSQL_RES* result ) {
+   return static_cast<unsigned int>( static_cast<FakeResult*>( result )->fieldList.size() );
+}
+
+MYSQL_FIELD* mysql_fetch_field_direct( MYSQL_RES* result, unsigned int fieldnr ) {
+   return &static_cast<FakeResult*>( result )->fieldList.at( fieldnr );
+}
+
+void mysql_free_result( MYSQL_RES* result ) { delete static_cast<FakeResult*>( result ); }
+
+// The non-blocking calls complete at once
+enum net_async_status mysql_real_connect_nonblocking( MYSQL* mysql, const char* host,
+                                                      const char* user, const char* passwd,
+                                                      const char* db, unsigned int port,
+                                                      const char* unix_socket,
+                                                      unsigned long clientflag ) {
+   return mysql_real_connect( mysql, host, user, passwd, db, port, unix_socket, clientflag )
+              ? NET_ASYNC_COMPLETE
+              : NET_ASYNC_ERROR;
+}
+
+enum net_async_status mysql_real_query_nonblocking( MYSQL* mysql, const char* query,
+                                                    unsigned long length ) {
+   return mysql_real_query( mysql, query, length ) ? NET_ASYNC_ERROR : NET_ASYNC_COMPLETE;
+}
+
+enum net_async_status mysql_store_result_nonblocking( MYSQL* mysql, MYSQL_RES** result ) {
+   *result = mysql_store_result( mysql );
+   return NET_ASYNC_COMPLETE;
+}
+
+enum net_async_status mysql_fetch_row_nonblocking( MYSQL_RES* result, MYSQL_ROW* row ) {
+   *row = mysql_fetch_row( result );
+   return NET_ASYNC_COMPLETE;
+}
+
+enum net_async_status mysql_free_result_nonblocking( MYSQL_RES* result ) {
+   mysql_free_result( result );
+   return NET_ASYNC_COMPLETE;
+}
+
+// Prepared statements ****************************************************************************
+
+MYSQL_STMT* mysql_stmt_init( MYSQL* mysql ) { return new FakeStatement( mysql ); }
+
+bool mysql_stmt_close( MYSQL_STMT* stmt ) {
+   delete &statementOf( stmt );
+   return false;
+}
+
+int mysql_stmt_prepare( MYSQL_STMT* stmt, const char* query, unsigned long length ) {
+   FakeStatement& statement = statementOf( stmt );
+   statement.error.clear();
+   statement.prepared = statement.executed = statement.paramsBound = statement.hasRow = false;
+   statement.source = currentSchema();
+   if ( parseQuery( { query, length }, *statement.source, statement.query, statement.error ) ) {
+      return 1;
+   }
+   statement.prepared = true;
+   statement.values.resize( statement.query.columns.size() );
+   statement.results.clear();
+   return 0;
+}
+
+unsigned long mysql_stmt_param_count( MYSQL_STMT* stmt ) {
+   return statementOf( stmt ).query.paramCount;
+}
+
+unsigned int mysql_stmt_field_count( MYSQL_STMT* stmt ) {
+   return static_cast<unsigned int>( statementOf( stmt ).query.columns.size() );
+}
+
+bool mysql_stmt_attr_set( MYSQL_STMT* stmt, enum enum_stmt_attr_type attr_type,
+                          const void* attr ) {
+   FakeStatement& statement = statementOf( stmt );
+   switch ( attr_type ) {
+      case STMT_ATTR_UPDATE_MAX_LENGTH:
+         statement.updateMaxLength = *static_cast<const bool*>( attr );
+         return false;
+      case STMT_ATTR_CURSOR_TYPE:
+         statement.cursorType = *static_cast<const unsigned long*>( attr );
+         return false;
+      case STMT_ATTR_PREFETCH_ROWS:
+         statement.prefetchRows = *static_cast<const unsigned long*>( attr );
+         return false;
+      default:
+         return true;
+   }
+}
+
+bool mysql_stmt_attr_get( MYSQL_STMT* stmt, enum enum_stmt_attr_type attr_type, void* attr ) {
+   FakeStatement& statement = statementOf( stmt );
+   switch ( attr_type ) {
+      case STMT_ATTR_UPDATE_MAX_LENGTH:
+         *static_cast<bool*>( attr ) = statement.updateMaxLength;
+         return false;
+      case STMT_ATTR_CURSOR_TYPE:
+         *static_cast<unsigned long*>( attr ) = statement.cursorType;
+         return false;
+      case STMT_ATTR_PREFETCH_ROWS:
+         *static_cast<unsigned long*>( attr ) = statement.prefetchRows;
+         return false;
+      default:
+         return true;
+   }
+}
+
+bool mysql_stmt_bind_param( MYSQL_STMT* stmt, MYSQL_BIND* bnd ) {
+   FakeStatement& statement = statementOf( stmt );
+   if ( !statement.prepared ) {
+      return statement.error.fail( notPrepared, "Statement not prepared" );
+   }
+   statement.params.assign( bnd, bnd + statement.query.paramCount );
+   statement.paramsBound = true;
+   return false;
+}
+
+bool mysql_stmt_bind_result( MYSQL_STMT* stmt, MYSQL_BIND* bnd ) {
+   FakeStatement& statement = statementOf( stmt );
+   if ( !statement.prepared ) {
+      return statement.error.fail( notPrepared, "Statement not prepared" );
+   }
+   statement.results.assign( bnd, bnd + statement.query.columns.size() );
+   return false;
+}
+
+int mysql_stmt_execute( MYSQL_STMT* stmt ) {
+   FakeStatement& statement = statementOf( stmt );
+   if ( !statement.prepared ) {
+      return statement.error.fail( notPrepared, "Statement not prepared" );
+   }
+   if ( statement.query.paramCount && !statement.paramsBound ) {
+      return statement.error.fail( paramsNotBound,
+                                   "No data supplied for parameters in prepared statement" );
+   }
+   statement.error.clear();
+   statement.executed = true;
+   statement.stored = statement.hasRow = false;
+   statement.nextRow = 0;
+   if ( statement.query.isSelect ) {
+      statement.affectedRows = ~0ULL;
+   } else {
+      statement.affectedRows = statement.query.affectedRows;
+      if ( statement.query.isInsert ) {
+         statement.insertId = statement.connection->nextInsertId;
+         statement.connection->nextInsertId += statement.query.affectedRows;
+      }
+   }
+   return 0;
+}
+
+int mysql_stmt_store_result( MYSQL_STMT* stmt ) {
+   FakeStatement& statement = statementOf( stmt );
+   if ( statement.executed && statement.query.isSelect ) {
+      statement.stored = true;
+      statement.affectedRows = statement.query.rows;
+   }
+   return 0;
+}
+
+int mysql_stmt_fetch( MYSQL_STMT* stmt ) {
+   FakeStatement& statement = statementOf( stmt );
+   if ( !statement.executed || !statement.query.isSelect ) {
+      return statement.error.fail(
+          noResultSet,
+          "Attempt to read a row while there is no result set associated with the statement" );
+   }
+   if ( statement.nextRow >= statement.query.rows ) {
+      statement.hasRow = false;
+      return MYSQL_NO_DATA;
+   }
+   bool truncated = false;
+   for ( size_t c = 0; c < statement.values.size(); ++c ) {
+      generate( *statement.query.columns[ c ], c, statement.nextRow, statement.values[ c ] );
+      if ( c < statement.results.size() ) {
+         truncated |= writeBind( statement.results[ c ], statement.values[ c ],
+                                 statement.query.columns[ c ]->type );
+      }
+   }
+   ++statement.nextRow;
+   statement.hasRow = true;
+   return truncated ? MYSQL_DATA_TRUNCATED : 0;
+}
+
+int mysql_stmt_fetch_column( MYSQL_STMT* stmt, MYSQL_BIND* bind_arg, unsigned int column,
+                             unsigned long offset ) {
+   FakeStatement& statement = statementOf( stmt );
+   if ( !statement.hasRow ) {
+      return statement.error.fail( noData, "Attempt to read column without prior row fetch" );
+   }
+   if ( column >= statement.values.size() ) {
+      return statement.error.fail( invalidParameterNumber, "Invalid parameter number" );
+   }
+   writeBind( *bind_arg, statement.values[ column ], statement.query.columns[ column ]->type,
+              offset );
+   return 0;
+}
+
+bool mysql_stmt_free_result( MYSQL_STMT* stmt ) {
+   FakeStatement& statement = statementOf( stmt );
+   statement.hasRow = false;
+   statement.nextRow = statement.query.rows;
+   return false;
+}
+
+bool mysql_stmt_reset( MYSQL_STMT* stmt ) {
+   FakeStatement& statement = statementOf( stmt );
+   statement.error.clear();
+   statement.executed = statement.hasRow = statement.stored = false;
+   return false;
+}
+
+MYSQL_RES* mysql_stmt_result_metadata( MYSQL_STMT* stmt ) {
+   FakeStatement& statement = statementOf( stmt );
+   if ( !statement.prepared || !statement.query.isSelect ) {
+      return nullptr;
+   }
+   return new FakeResult( statement.source, statement.query, false );
+}
+
+unsigned int mysql_stmt_errno( MYSQL_STMT* stmt ) { return statementOf( stmt ).error.code; }
+const char* mysql_stmt_error( MYSQL_STMT* stmt ) {
+   return statementOf( stmt ).error.message.c_str();
+}
+
+uint64_t mysql_stmt_num_rows( MYSQL_STMT* stmt ) {
+   FakeStatement& statement = statementOf( stmt );
+   return statement.stored ? statement.query.rows : 0;
+}
+
+uint64_t mysql_stmt_affected_rows( MYSQL_STMT* stmt ) {
+   return statementOf( stmt ).affectedRows;
+}
+
+uint64_t mysql_stmt_insert_id( MYSQL_STMT* stmt ) { return statementOf( stmt ).insertId; }
+
+}  // extern "C"
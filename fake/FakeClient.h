@@ -0,0 +1,56 @@
+#ifndef INCLUDED_FAKECLIENT_H
+#define INCLUDED_FAKECLIENT_H
+
+#include <mysql/mysql.h>
+
+#include <string_view>
+#include <vector>
+
+#include "getDBTables.h"
+
+/*
+    An in-process stand-in for libmysqlclient. Configuring with -DSET_MYSQL_BINDS_FAKE_CLIENT=ON
+   links it in place of mysqlclient, so the fetch and bind paths can be benchmarked and profiled
+   with no mysqld and no network in the way. Headers stay the real <mysql/mysql.h>, nothing using
+   the library changes.
+
+    Result sets come from the std::vector<Table> given to setTables(), the description getDBTables()
+   returns, so a schema can be captured once from a real server and replayed. A statement (prepared
+   or text protocol)
+      SELECT a, b FROM t [WHERE ...] [LIMIT n]      or      SELECT * FROM t ...
+   returns the rows of columns a and b (or all) of table t, the WHERE clause is ignored. Any other
+   statement succeeds, an INSERT reports one affected row per VALUES row, anything else one. The
+   value of row r in result column c is deterministic:
+      integers            r * 31 + c narrowed to the column type, YEAR 1901 + r % 255
+      FLOAT, DOUBLE       r / 2 + c
+      DECIMAL             its text, r within the precision and scale
+      DATE, DATETIME      day r of a 28 day month calendar from 2000-01-01, clock from r
+      TIME                r % 839 hours
+      char[] columns      "<column>-<r>" cut to the column's maxLength, JSON {"row": r}
+   and columns without NOT_NULL_FLAG are NULL every 16th row.
+
+    mysql_stmt_fetch() converts each value to the buffer_type of its MYSQL_BIND as the real client
+   does, sets length, is_null and error (MYSQL_BIND pointers left null are allowed) and returns
+   MYSQL_DATA_TRUNCATED when a char[] value did not fit, mysql_stmt_fetch_column() then fetches it
+   again from an offset. The text protocol returns the same values as text, the non-blocking calls
+   complete at once.
+
+    LOAD DATA LOCAL INFILE reads its stream through the callbacks of
+   mysql_set_local_infile_handler() in 16 KiB packets, as the real client does, and reports one
+   affected row per line. Without a handler it fails, files are not read.
+
+    Not emulated: information_schema (getDBTables() itself), multiple statements or result sets,
+   server side cursors beyond accepting the attributes, parameter values (they are bound, not read).
+*/
+
+namespace set_mysql_binds::fake {
+
+// Replaces the tables statements read from. Call it before statements are prepared, those already
+// prepared keep the tables they were prepared against.
+void setTables( std::vector<Table> tables, unsigned long long rowCount = 1000 );
+// Rows every SELECT returns before its LIMIT
+void setRowCount( unsigned long long rowCount );
+
+}  // namespace set_mysql_binds::fake
+
+#endif  // INCLUDED_FAKECLIENT_H
@@ -0,0 +1,90 @@
+#ifndef INCLUDED_ARROWEXPORT_H
+#define INCLUDED_ARROWEXPORT_H
+
+#include <cstdint>
+
+#include "ColumnarBatch.h"
+
+/*
+    Export of a ColumnarBatch through the Arrow C Data Interface, the stable C ABI any Arrow
+   implementation (Arrow C++, pyarrow, arrow-rs, DuckDB, ...) imports from. Nothing of Arrow is
+   linked, the two structs below are the ones the interface defines, to be copied verbatim.
+
+    exportArrow() produces a struct array ("+s") with one child per column of the batch and moves
+   the batch's buffers into it: integer, floating point and string columns are handed over as
+   they are, only temporal columns are converted, as Arrow counts time from the epoch where
+   MYSQL_TIME holds broken down fields. The consumer owns the result and frees it by calling the
+   release callbacks of the schema and the array, as the interface requires.
+
+   MySQL                                         Arrow
+   TINYINT, SMALLINT, INT, MEDIUMINT, BIGINT     int8, int16, int32, int32, int64 (uint* unsigned)
+   YEAR, BIT                                     int16, uint64
+   FLOAT, DOUBLE                                 float32, float64
+   DATE                                          date32 (days)
+   DATETIME, TIMESTAMP                           timestamp[us], no time zone
+   TIME                                          duration[us], TIME spans -838:59:59 to 838:59:59
+   CHAR, VARCHAR, DECIMAL, ENUM, SET, JSON       utf8 (DECIMAL as its text)
+   BINARY, VARBINARY, *BLOB, *TEXT, GEOMETRY     binary, or utf8 with blobsAsUtf8
+*/
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+   // Array type description
+   const char* format;
+   const char* name;
+   const char* metadata;
+   int64_t flags;
+   int64_t n_children;
+   struct ArrowSchema** children;
+   struct ArrowSchema* dictionary;
+
+   // Release callback
+   void ( *release )( struct ArrowSchema* );
+   // Opaque producer-specific data
+   void* private_data;
+};
+
+struct ArrowArray {
+   // Array data description
+   int64_t length;
+   int64_t null_count;
+   int64_t offset;
+   int64_t n_buffers;
+   int64_t n_children;
+   const void** buffers;
+   struct ArrowArray** children;
+   struct ArrowArray* dictionary;
+
+   // Release callback
+   void ( *release )( struct ArrowArray* );
+   // Opaque producer-specific data
+   void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+namespace set_mysql_binds {
+
+struct ArrowExportOptions {
+   // TEXT columns are bound with the BLOB buffer types, set when the blobs of the batch are text
+   bool blobsAsUtf8 = false;
+};
+
+// The Arrow format string of a column, throws std::runtime_error for a buffer type with no
+// mapping
+const char* arrowFormat( const ColumnarColumn& column, const ArrowExportOptions& options = {} );
+
+// Moves the rows of batch into schema and array and leaves batch empty. Throws std::runtime_error
+// before anything is moved if a column cannot be exported.
+void exportArrow( ColumnarBatch& batch, ArrowSchema* schema, ArrowArray* array,
+                  const ArrowExportOptions& options = {} );
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_ARROWEXPORT_H
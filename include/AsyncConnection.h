@@ -0,0 +1,69 @@
+#ifndef INCLUDED_ASYNCCONNECTION_H
+#define INCLUDED_ASYNCCONNECTION_H
+
+#include <mysql/mysql.h>
+
+#include <string_view>
+
+#include "BindsArray.hpp"
+#include "ConnectionPool.h"
+#include "EventLoop.h"
+#include "SqlTypes/SqlTypes.h"
+#include "Task.hpp"
+
+/*
+    An AsyncConnection drives one connection through libmysqlclient's *_nonblocking functions
+   from coroutines, suspending on its EventLoop whenever the library reports NET_ASYNC_NOT_READY,
+   so one thread can keep as many queries in flight as it has connections:
+
+      Task<void> count( AsyncConnection& conn, BindsArray<OutputCType>& result ) {
+         co_await conn.connect( options );
+         co_await conn.query( "SELECT COUNT(*) FROM orders" );
+         while ( co_await conn.fetchRow( result ) ) { ... }
+      }
+
+    The non-blocking API has no prepared statements, so queries go through the text protocol and
+   fetchRow() parses each row into the selected binds of a BindsArray<OutputCType> with
+   textToBind(). Results are streamed (mysql_use_result()), a row is read off the socket only when
+   fetchRow() asks for it, and every row of a result has to be fetched, or freeResult() awaited,
+   before the next query. Like any coroutine arguments, the options, sql and BindsArray passed in
+   have to stay alive until the returned Task has been awaited.
+*/
+
+namespace set_mysql_binds {
+
+class AsyncConnection {
+  private:
+   EventLoop& loop;
+   MYSQL* mysql;
+   MYSQL_RES* result;
+
+   EventLoop::SocketReady socketReady();
+   void throwError();
+
+  public:
+   AsyncConnection() = delete;
+   explicit AsyncConnection( EventLoop& _loop );
+   AsyncConnection( const AsyncConnection& ) = delete;
+   AsyncConnection& operator=( const AsyncConnection& ) = delete;
+   ~AsyncConnection();
+
+   // All of them throw std::runtime_error with the client library's message on failure
+   Task<void> connect( const ConnectionOptions& options );
+   // Sends sql and, for a statement returning rows, starts streaming its result
+   Task<void> query( std::string_view sql );
+   // Reads the next row of the current result into the selected binds of row, false once the
+   // result is exhausted. Throws std::runtime_error, after freeing the result, when row does not
+   // have one bind per column or a value is not valid for its bind's type
+   Task<bool> fetchRow( BindsArray<OutputCType>& row );
+   // Reads and drops whatever is left of the current result
+   Task<void> freeResult();
+
+   bool hasResult() const { return result != nullptr; }
+   unsigned long long affectedRows() { return mysql_affected_rows( mysql ); }
+   MYSQL* handle() { return mysql; }
+};
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_ASYNCCONNECTION_H
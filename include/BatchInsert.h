@@ -0,0 +1,82 @@
+#ifndef INCLUDED_BATCHINSERT_H
+#define INCLUDED_BATCHINSERT_H
+
+#include <mysql/mysql.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BindsArray.hpp"
+#include "SqlTypes/SqlTypes.h"
+
+/*
+    BatchInsert writes rows through multi-row "INSERT INTO table (...) VALUES (?,?..),(?,?..)"
+   prepared statements instead of one mysql_stmt_execute() per row.
+
+    It takes the selected columns of a BindsArray<InputCType> (as made by makeInputBindsArray() or
+   a generated <table>InputBindsArray()) as the layout of one row. Each call to addRow() copies the
+   current values of those binds into the next slot of a staging area, and the staging area is
+   described by a single contiguous MYSQL_BIND array of maxRows x getBindsSize() entries. Staged
+   rows are sent when maxRows is reached, when the next row would go over maxBytes, or when
+   flush() is called. When sending fails the rows stay staged and the next addRow() or flush()
+   sends them again.
+
+    The selection of the layout BindsArray must not change for the lifetime of the BatchInsert.
+   Rows still staged when the object is destroyed are discarded, so call flush() when done.
+*/
+
+namespace set_mysql_binds {
+
+class BatchInsert {
+  private:
+   MYSQL* conn;
+   BindsArray<InputCType>& layout;
+   std::string table;
+   std::vector<std::string> columnNames;
+   size_t columnCount;
+   size_t maxRows;
+   size_t maxBytes;
+
+   // per column offset into a staged row and the capacity reserved for it
+   std::vector<size_t> offsets;
+   std::vector<unsigned long> capacities;
+   size_t rowStride;
+
+   std::vector<unsigned char> data;
+   std::vector<unsigned long> lengths;
+   std::unique_ptr<bool[]> nulls;
+   std::vector<MYSQL_BIND> binds;  // maxRows * columnCount, row major
+
+   size_t rows;
+   size_t bytes;
+   unsigned long long written;
+   MYSQL_STMT* fullStmt;  // prepared on first full flush for maxRows rows
+
+   std::string makeInsertQuery( size_t rowCount ) const;
+   MYSQL_STMT* prepare( size_t rowCount );
+   void execute( MYSQL_STMT* stmt, size_t rowCount );
+
+  public:
+   BatchInsert() = delete;
+   BatchInsert( MYSQL* _conn, std::string_view _table, BindsArray<InputCType>& _layout,
+                size_t _maxRows = 256, size_t _maxBytes = 1024 * 1024 );
+   BatchInsert( const BatchInsert& ) = delete;
+   BatchInsert& operator=( const BatchInsert& ) = delete;
+   ~BatchInsert();
+
+   // Copies the current values of the layout's selected binds into the next staging slot,
+   // flushing first if the row would not fit in the row count or byte budget.
+   void addRow();
+   // Sends all staged rows, returns how many were written
+   size_t flush();
+
+   size_t stagedRows() const { return rows; }
+   size_t stagedBytes() const { return bytes; }
+   unsigned long long rowsWritten() const { return written; }
+};
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_BATCHINSERT_H
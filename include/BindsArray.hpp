@@ -2,14 +2,23 @@
 #define INCLUDED_BINDS_H
 
 #include <algorithm>
+#include <atomic>
 #include <exception>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
-#include "SqlTypes/SqlCType.h"
+#include "ColumnArena.hpp"
+#include "FieldHash.hpp"
+#include "SqlTypes/SqlTypes.h"
 #include "utilities.h"
 
 /*
@@ -19,20 +28,89 @@
    write/modify statement then the values of each field can be updated between statement
    executions. If it is a read statement, then updated values can be read between
    executions if they have changed.
+
+    When built through the arena construction mode (makeArenaInputBindsArray() and
+   makeArenaOutputBindsArray()) the column objects, their value buffers, the MYSQL_BIND array and
+   the lookup containers all live in a single ColumnArena owned by the BindsArray (only the public
+   fields vector of column pointers stays on the heap). Move-assigning one destroys its columns
+   before its arena and takes over the other's arena.
+
+    Projections are named, precompiled selections for when one BindsArray serves several statement
+   shapes. addProjection() builds the column bitmask, its own MYSQL_BIND array and the matching
+   "SELECT col_a, col_b FROM table" text once, useProjection() then switches getBinds() over to it
+   in O(1) without touching the columns. setBinds() goes back to the is_selected selection.
+
+    The BindsArray functions createDBTableBinds() generates also give it their table's FieldHash
+   (FieldHash.hpp) through useFieldHash(), so operator[] by name is a perfect hash probe instead of
+   a hash map lookup, and declare an enum of the table's columns for operator[] by column ID.
 */
 
 namespace set_mysql_binds {
 
+namespace detail {
+
+// Binds versions come from one counter for the whole process, so an array built where a destroyed
+// one was never has a version that array had
+inline unsigned long long nextBindsVersion() {
+   static std::atomic<unsigned long long> counter = 0;
+   return ++counter;
+}
+
+}  // namespace detail
+
+// Deletes heap allocated columns, only destroys columns that were placed in a ColumnArena
 template <typename T>
-class BindsArray {
+struct ColumnDeleter {
+   bool inArena = false;
+   void operator()( T* column ) const {
+      if ( inArena ) {
+         column->~T();
+      } else {
+         delete column;
+      }
+   }
+};
+
+template <typename T>
+using ColumnPtr = std::unique_ptr<T, ColumnDeleter<T>>;
+
+// The Checking policy (InputCType.hpp) applies to set(), BindsArray<T> is
+// BindsArray<T, StrictChecking> and any other policy derives from it, so it is passed wherever a
+// BindsArray<T>& is taken.
+template <typename T, typename Checking = StrictChecking>
+class BindsArray;
+
+template <typename T>
+class BindsArray<T, StrictChecking> : private BindsOwner {
   private:
-   std::vector<std::unique_ptr<T>> columns;
-   std::vector<MYSQL_BIND> selection;
+   std::unique_ptr<ColumnArena> arena;  // declared first so it outlives everything placed in it
+   std::pmr::vector<ColumnPtr<T>> columns;
+   std::pmr::vector<MYSQL_BIND> selection;
 
    // linked to BindsArray::operator[] and Points to columns' elements.
    // After object instantiated, do not want column elements added or deleted,
    // just access for selecting and modifying.
-   std::unordered_map<std::string_view, T*> fieldsMap;
+   std::pmr::unordered_map<std::string_view, T*> fieldsMap;
+   // replaces fieldsMap for lookups by name once useFieldHash() was called
+   FieldIndex fieldIndex;
+
+   struct Projection {
+      std::string name;
+      std::vector<unsigned long long> mask;  // bit i set when fields[ i ] is in the projection
+      std::vector<MYSQL_BIND> binds;
+      std::string selectText;
+   };
+   std::vector<Projection> projections;
+   std::unordered_map<std::string, size_t> projectionIds;
+   size_t activeProjection;
+   // bumped whenever getBinds() may point somewhere else, see getBindsVersion()
+   unsigned long long bindsVersion;
+
+   void indexColumns();
+   void adoptColumns();
+   void bufferMoved( SqlCType& column ) override;
+   bool isSelected( size_t index ) const;
+   T* findField( std::string_view fieldName ) const;
 
   public:
    std::vector<T*> fields;
@@ -40,6 +118,19 @@ class BindsArray {
    BindsArray(
        std::vector<std::unique_ptr<T>> _columns );  // To set once the correct order of
                                                     // MYSQL_BINDs for the prepared statement.
+   // Takes ownership of columns that were constructed inside _arena
+   BindsArray( std::unique_ptr<ColumnArena> _arena, std::span<T* const> _columns );
+   BindsArray( BindsArray&& other );
+   // Destroys the current columns before the arena they may live in, then takes over other's
+   BindsArray& operator=( BindsArray&& other );
+
+   // Bytes an arena needs, besides the columns themselves, for a BindsArray of columnCount columns
+   static constexpr size_t arenaOverhead( size_t columnCount ) {
+      constexpr size_t mapNode = 4 * sizeof( void* );
+      return columnCount * ( sizeof( ColumnPtr<T> ) + sizeof( MYSQL_BIND ) +
+                             mapNode + 2 * sizeof( void* ) ) +
+             4 * ColumnArena::cacheLine;
+   }
 
    void displayAllFields() const;
    void displaySelectedFields() const;
@@ -48,24 +139,210 @@ class BindsArray {
    void setBinds();
    // Names given to overloaded method will be only ones marked is_selected and bound
    void setBinds( const std::vector<std::string_view>& sc );
-   MYSQL_BIND* getBinds() { return selection.data(); }
+
+   static constexpr size_t noProjection = static_cast<size_t>( -1 );
+   // Precompiles the selection sc (bound in column order) as projection name of table and
+   // returns its id for useProjection()
+   size_t addProjection( std::string_view name, const std::vector<std::string_view>& sc,
+                         std::string_view table );
+   void useProjection( size_t id );
+   size_t useProjection( std::string_view name );
+   size_t getActiveProjection() const { return activeProjection; }
+   const std::string& getSelectText( size_t id ) const { return projections.at( id ).selectText; }
+
+   MYSQL_BIND* getBinds() {
+      return activeProjection == noProjection ? selection.data()
+                                              : projections[ activeProjection ].binds.data();
+   }
    size_t getBindsSize() const {  // for testing during development
-      return selection.size();
+      return activeProjection == noProjection ? selection.size()
+                                              : projections[ activeProjection ].binds.size();
    }
+   // Names of the bound fields, in the order of getBinds()
+   std::vector<std::string_view> selectedFieldNames() const;
+   // Changes every time the selection or projection changes or a buffer is moved, so a statement
+   // bound to getBinds() only needs binding again when the version it was bound at is stale. No
+   // two BindsArrays share a version.
+   unsigned long long getBindsVersion() const { return bindsVersion; }
+   // After mysql_stmt_fetch() returned MYSQL_DATA_TRUNCATED, grows the buffers of the truncated
+   // char[] columns to their full length, fetches only those columns again with
+   // mysql_stmt_fetch_column() and rebinds the result so later rows fit. Returns how many columns
+   // were fetched again.
+   size_t refetchTruncated( MYSQL_STMT* stmt )
+      requires std::same_as<T, OutputCType>;
+
+   // Looks names up through hash, which must list the fields in column order and outlive this
+   template <size_t N>
+   void useFieldHash( const FieldHash<N>& hash );
+   template <size_t N>
+   void useFieldHash( const FieldHash<N>&& hash ) = delete;
+
    [[nodiscard]] T& operator[]( std::string_view fieldName );
    [[nodiscard]] T& operator[]( size_t index );
+   // Column ID of the enum generated with the table, its values are the column indexes
+   template <typename E>
+      requires std::is_enum_v<E>
+   [[nodiscard]] T& operator[]( E column ) {
+      return *fields[ static_cast<size_t>( column ) ];
+   }
+
+   // Typed writes through InputCType::set() with StrictChecking, column is a name, an index or a
+   // column ID
+   template <MysqlInputType type, typename Column, typename V>
+      requires std::same_as<T, InputCType>
+   void set( Column column, V newValue ) {
+      ( *this )[ column ].template set<type, StrictChecking>( newValue );
+   }
+   template <ApprovedType C, typename Column, typename V>
+      requires std::same_as<T, InputCType>
+   void set( Column column, V newValue ) {
+      ( *this )[ column ].template set<C, StrictChecking>( newValue );
+   }
+};
+
+template <typename T, typename Checking>
+class BindsArray : public BindsArray<T, StrictChecking> {
+  public:
+   // Takes over the columns of binds, as made by makeInputBindsArray() or a generated function
+   BindsArray( BindsArray<T, StrictChecking>&& binds )
+       : BindsArray<T, StrictChecking>( std::move( binds ) ) {}
+
+   template <MysqlInputType type, typename Column, typename V>
+      requires std::same_as<T, InputCType>
+   void set( Column column, V newValue ) {
+      ( *this )[ column ].template set<type, Checking>( newValue );
+   }
+   template <ApprovedType C, typename Column, typename V>
+      requires std::same_as<T, InputCType>
+   void set( Column column, V newValue ) {
+      ( *this )[ column ].template set<C, Checking>( newValue );
+   }
 };
 
 template <typename T>
 BindsArray<T>::BindsArray( std::vector<std::unique_ptr<T>> _columns )
-    : columns( std::move( _columns ) ) {
+    : activeProjection( noProjection ), bindsVersion( 0 ) {
+   columns.reserve( _columns.size() );
+   std::for_each( _columns.begin(), _columns.end(),
+                  [ & ]( auto& column ) { columns.emplace_back( column.release() ); } );
+   indexColumns();
+}
+
+template <typename T>
+BindsArray<T>::BindsArray( std::unique_ptr<ColumnArena> _arena, std::span<T* const> _columns )
+    : arena( std::move( _arena ) ),
+      columns( arena->memoryResource() ),
+      selection( arena->memoryResource() ),
+      fieldsMap( arena->memoryResource() ),
+      activeProjection( noProjection ),
+      bindsVersion( 0 ) {
+   columns.reserve( _columns.size() );
+   std::for_each( _columns.begin(), _columns.end(), [ & ]( T* column ) {
+      columns.emplace_back( column, ColumnDeleter<T>{ true } );
+   } );
+   indexColumns();
+}
+
+template <typename T>
+BindsArray<T>::BindsArray( BindsArray&& other )
+    : arena( std::move( other.arena ) ),
+      columns( std::move( other.columns ) ),
+      selection( std::move( other.selection ) ),
+      fieldsMap( std::move( other.fieldsMap ) ),
+      fieldIndex( other.fieldIndex ),
+      projections( std::move( other.projections ) ),
+      projectionIds( std::move( other.projectionIds ) ),
+      activeProjection( other.activeProjection ),
+      bindsVersion( other.bindsVersion ),
+      fields( std::move( other.fields ) ) {
+   adoptColumns();
+}
+
+template <typename T>
+BindsArray<T>& BindsArray<T>::operator=( BindsArray&& other ) {
+   if ( this == &other ) {
+      return *this;
+   }
+   // pmr containers keep the memory resource they were made with whatever is assigned to them,
+   // so the ones that may live in the arena are destroyed before it and made again from other's
+   std::destroy_at( &fieldsMap );
+   std::destroy_at( &selection );
+   std::destroy_at( &columns );
+   arena = std::move( other.arena );
+   std::construct_at( &columns, std::move( other.columns ) );
+   std::construct_at( &selection, std::move( other.selection ) );
+   std::construct_at( &fieldsMap, std::move( other.fieldsMap ) );
+   fieldIndex = other.fieldIndex;
+   projections = std::move( other.projections );
+   projectionIds = std::move( other.projectionIds );
+   activeProjection = other.activeProjection;
+   bindsVersion = other.bindsVersion;
+   fields = std::move( other.fields );
+   adoptColumns();
+   return *this;
+}
+
+template <typename T>
+void BindsArray<T>::indexColumns() {
+   fieldsMap.reserve( columns.size() );
+   fields.reserve( columns.size() );
+   // reserved up front so setBinds() never reallocates and the SqlCType::bind pointers stay valid
+   selection.reserve( columns.size() );
    std::for_each( columns.begin(), columns.end(), [ & ]( const auto& column ) {
       fieldsMap[ column->fieldName ] = column.get();
       fields.push_back( column.get() );
    } );
+   adoptColumns();
    BindsArray<T>::setBinds();
 }
 
+// Makes this the owner the columns tell about buffer moves
+template <typename T>
+void BindsArray<T>::adoptColumns() {
+   std::for_each( columns.begin(), columns.end(),
+                  [ & ]( auto& column ) { column->owner = this; } );
+}
+
+// Every bind array holding the column, the selection and all projections, follows its buffer
+template <typename T>
+void BindsArray<T>::bufferMoved( SqlCType& column ) {
+   auto repoint = [ & ]( MYSQL_BIND& bind ) {
+      if ( bind.length == &column.length ) {
+         bind.buffer = column.buffer;
+         bind.buffer_length = column.bufferLength;
+      }
+   };
+   std::for_each( selection.begin(), selection.end(), repoint );
+   std::for_each( projections.begin(), projections.end(), [ & ]( auto& projection ) {
+      std::for_each( projection.binds.begin(), projection.binds.end(), repoint );
+   } );
+   bindsVersion = detail::nextBindsVersion();
+}
+
+template <typename T>
+T* BindsArray<T>::findField( std::string_view fieldName ) const {
+   if ( !fieldIndex.empty() ) {
+      size_t index = fieldIndex.find( fieldName );
+      return index == FieldIndex::npos ? nullptr : fields[ index ];
+   }
+   auto found = fieldsMap.find( fieldName );
+   return found == fieldsMap.end() ? nullptr : found->second;
+}
+
+template <typename T>
+template <size_t N>
+void BindsArray<T>::useFieldHash( const FieldHash<N>& hash ) {
+   FieldIndex index = hash.index();
+   bool matches = index.names.size() == fields.size();
+   for ( size_t i = 0; i < fields.size() && matches; ++i ) {
+      matches = index.names[ i ] == fields[ i ]->fieldName;
+   }
+   if ( !matches ) {
+      throw std::runtime_error( "FieldHash names do not match the fields of the Binds object\n" );
+   }
+   fieldIndex = index;
+}
+
 template <typename T>
 void BindsArray<T>::displayAllFields() const {
    puts( "" );
@@ -77,7 +354,7 @@ void BindsArray<T>::displayAllFields() const {
    std::for_each( columns.begin(), columns.end(), [ & ]( const auto& o ) {
       std::cout << std::left << std::setw( 45 ) << o->fieldName;
       std::cout << std::left << std::setw( 30 ) << fieldTypes[ o->bufferType ];
-      std::cout << std::left << o << std::endl;
+      std::cout << std::left << *o << '\n';
    } );
    puts( "" );
 }
@@ -90,18 +367,42 @@ void BindsArray<T>::displaySelectedFields() const {
    std::cout << std::left << std::setw( 30 ) << "Field Value" << '\n';
    std::cout << std::left << std::setw( 105 ) << std::setfill( '-' ) << '-' << std::setfill( ' ' )
              << '\n';
+   size_t index = 0;
    std::for_each( columns.begin(), columns.end(), [ & ]( const auto& o ) {
-      if ( o->is_selected ) {
+      if ( isSelected( index++ ) ) {
          std::cout << std::left << std::setw( 45 ) << o->fieldName;
          std::cout << std::left << std::setw( 30 ) << fieldTypes[ o->bufferType ];
-         std::cout << std::left << o << std::endl;
+         std::cout << std::left << *o << '\n';
       }
    } );
    puts( "" );
 }
 
+template <typename T>
+bool BindsArray<T>::isSelected( size_t index ) const {
+   if ( activeProjection == noProjection ) {
+      return columns[ index ]->is_selected;
+   }
+   return ( projections[ activeProjection ].mask[ index / 64 ] >> ( index % 64 ) ) & 1;
+}
+
+template <typename T>
+std::vector<std::string_view> BindsArray<T>::selectedFieldNames() const {
+   std::vector<std::string_view> names;
+   names.reserve( getBindsSize() );
+   for ( size_t i = 0; i < columns.size(); ++i ) {
+      if ( isSelected( i ) ) {
+         names.push_back( columns[ i ]->fieldName );
+      }
+   }
+   return names;
+}
+
 template <typename T>
 void BindsArray<T>::setBinds() {
+   activeProjection = noProjection;
+   bindsVersion = detail::nextBindsVersion();
+   selection.erase( selection.begin(), selection.end() );  // in case a previous selection was made
    std::for_each( columns.begin(), columns.end(), [ & ]( auto& o ) {
       if ( o->is_selected ) {
          selection.emplace_back();
@@ -114,33 +415,129 @@ template <typename T>
 void BindsArray<T>::setBinds( const std::vector<std::string_view>& sc ) {
    // to ensure arguments are valid
    std::for_each( sc.begin(), sc.end(), [ & ]( auto fieldName ) {
-      auto found = std::find_if( columns.begin(), columns.end(),
-                                 [ & ]( auto& column ) { return column->fieldName == fieldName; } );
-      if ( found == columns.end() ) {
+      if ( !findField( fieldName ) ) {
          std::ostringstream os;
          os << "Invalid selection \"" << fieldName << "\" not found in Binds object";
          throw std::runtime_error( std::move( os.str() ) );
       }
    } );
 
-   // to ensure arguments are handled in the correct order
-   std::for_each( columns.begin(), columns.end(), [ & ]( auto& column ) {
-      auto it = std::find_if( sc.begin(), sc.end(),
-                              [ & ]( auto fieldName ) { return column->fieldName == fieldName; } );
-      if ( it != sc.end() ) {
-         column->is_selected = true;
-      } else {
-         column->is_selected = false;
-      }
+   // columns keep their own order whatever the order of the arguments
+   std::for_each( columns.begin(), columns.end(),
+                  [ & ]( auto& column ) { column->is_selected = false; } );
+   std::for_each( sc.begin(), sc.end(), [ & ]( auto fieldName ) {
+      findField( fieldName )->is_selected = true;
    } );
 
-   selection.erase( selection.begin(), selection.end() );  // in case a previous selection was made
    BindsArray<T>::setBinds();
 }
 
+template <typename T>
+size_t BindsArray<T>::addProjection( std::string_view name,
+                                     const std::vector<std::string_view>& sc,
+                                     std::string_view table ) {
+   if ( projectionIds.contains( std::string( name ) ) ) {
+      std::ostringstream os;
+      os << "Projection \"" << name << "\" already exists in Binds object";
+      throw std::runtime_error( std::move( os.str() ) );
+   }
+
+   Projection projection;
+   projection.name = name;
+   projection.mask.resize( ( columns.size() + 63 ) / 64 );
+   std::for_each( sc.begin(), sc.end(), [ & ]( auto fieldName ) {
+      T* found = findField( fieldName );
+      if ( !found ) {
+         std::ostringstream os;
+         os << "Invalid selection \"" << fieldName << "\" not found in Binds object";
+         throw std::runtime_error( std::move( os.str() ) );
+      }
+      size_t index = static_cast<size_t>(
+          std::find( fields.begin(), fields.end(), found ) - fields.begin() );
+      projection.mask[ index / 64 ] |= 1ULL << ( index % 64 );
+   } );
+
+   std::ostringstream selectText;
+   selectText << "SELECT ";
+   for ( size_t i = 0; i < columns.size(); ++i ) {
+      if ( ( projection.mask[ i / 64 ] >> ( i % 64 ) ) & 1 ) {
+         selectText << ( projection.binds.empty() ? "`" : ", `" ) << columns[ i ]->fieldName
+                    << '`';
+         projection.binds.emplace_back();
+         columns[ i ]->fillBind( &projection.binds.back() );
+      }
+   }
+   selectText << " FROM `" << table << '`';
+   projection.selectText = selectText.str();
+
+   projections.push_back( std::move( projection ) );
+   projectionIds.emplace( name, projections.size() - 1 );
+   return projections.size() - 1;
+}
+
+template <typename T>
+void BindsArray<T>::useProjection( size_t id ) {
+   if ( id >= projections.size() ) {
+      throw std::out_of_range( "Projection id provided to useProjection() does not exist\n" );
+   }
+   activeProjection = id;
+   bindsVersion = detail::nextBindsVersion();
+}
+
+template <typename T>
+size_t BindsArray<T>::useProjection( std::string_view name ) {
+   auto found = projectionIds.find( std::string( name ) );
+   if ( found == projectionIds.end() ) {
+      std::ostringstream os;
+      os << "Projection \"" << name << "\" not found in Binds object";
+      throw std::runtime_error( std::move( os.str() ) );
+   }
+   activeProjection = found->second;
+   bindsVersion = detail::nextBindsVersion();
+   return activeProjection;
+}
+
+template <typename T>
+size_t BindsArray<T>::refetchTruncated( MYSQL_STMT* stmt )
+   requires std::same_as<T, OutputCType>
+{
+   MYSQL_BIND* binds = getBinds();
+   size_t refetched = 0;
+   unsigned int position = 0;
+   for ( size_t i = 0; i < columns.size(); ++i ) {
+      if ( !isSelected( i ) ) {
+         continue;
+      }
+      T* column = columns[ i ].get();
+      if ( column->error && column->length > column->bufferLength ) {
+         if ( column->growBuffer( column->length ) ) {
+            column->bufferMoved();
+
+            if ( mysql_stmt_fetch_column( stmt, &binds[ position ], position, 0 ) ) {
+               throw std::runtime_error( mysql_stmt_error( stmt ) );
+            }
+            ++refetched;
+         }
+      }
+      ++position;
+   }
+
+   if ( refetched ) {
+      if ( mysql_stmt_bind_result( stmt, binds ) ) {
+         throw std::runtime_error( mysql_stmt_error( stmt ) );
+      }
+   }
+   return refetched;
+}
+
 template <typename T>
 T& BindsArray<T>::operator[]( std::string_view fieldName ) {
-   return *fieldsMap.at( fieldName );
+   T* field = findField( fieldName );
+   if ( !field ) {
+      throw std::out_of_range( "Field \"" + std::string( fieldName ) +
+                               "\" not found in Binds object" );
+   }
+   return *field;
 }
 
 template <typename T>
@@ -0,0 +1,99 @@
+#ifndef INCLUDED_BULKLOADER_H
+#define INCLUDED_BULKLOADER_H
+
+#include <mysql/mysql.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "BindsArray.hpp"
+#include "RowWriter.h"
+#include "SqlTypes/SqlTypes.h"
+
+/*
+    BulkLoader feeds rows to the server's bulk loader, "LOAD DATA LOCAL INFILE ... INTO TABLE",
+   for backfills where even a BatchInsert is too slow. No file is written: the stream the server
+   asks for is handed to it from memory through mysql_set_local_infile_handler().
+
+    Like BatchInsert it takes the selected columns of a BindsArray<InputCType> (as made by
+   makeInputBindsArray() or a generated <table>InputBindsArray()) as the layout of one row, those of
+   the active projection when one is in use, and each call to addRow() takes the current values of
+   those binds. The selection or projection must not change until finish(). addRow() writes them at
+   once in the default format of LOAD DATA (RowWriter's Tsv) into a chunk of about chunkBytes, on
+   the caller's thread. Full chunks are queued to a loading thread, which runs the LOAD DATA
+   statement and copies chunks into the packets the client library sends while the caller writes the
+   next one. At most maxQueued chunks wait, addRow() blocks while the server falls behind.
+
+    The connection needs MYSQL_OPT_LOCAL_INFILE set before connecting (ConnectionOptions::
+   localInfile) and the server local_infile=ON. It belongs to the loading thread from construction
+   until finish() returns, nothing else may use it meanwhile. LOAD DATA LOCAL turns duplicate key
+   and conversion errors into warnings, rows that fail them are skipped rather than failing the
+   load. Destroying a BulkLoader before finish() aborts the load.
+*/
+
+namespace set_mysql_binds {
+
+class BulkLoader {
+  private:
+   MYSQL* conn;
+   BindsArray<InputCType>& layout;
+   std::string table;
+   std::string query;
+   size_t chunkBytes;
+   size_t maxQueued;
+
+   std::string chunk;  // being written by the caller's thread
+   RowWriter writer;
+   unsigned long long added;
+
+   std::mutex mutex;
+   std::condition_variable changed;
+   std::deque<std::string> queued;   // full chunks for the loading thread
+   std::vector<std::string> spare;   // chunks sent, kept for their capacity
+   bool ended;                       // finish() queued the last chunk
+   bool aborted;                     // destroyed before finish()
+   bool done;                        // the LOAD DATA statement returned
+   std::string error;                // its error when it failed
+   unsigned long long loaded;
+
+   // The loading thread's chunk and how much of it went to the server
+   std::string reading;
+   size_t readOffset;
+   std::thread loader;
+
+   void load();
+   void queueChunk();
+   [[noreturn]] void throwLoadError();
+
+   // The local infile callbacks, called by the client library on the loading thread
+   static int initStream( void** stream, const char* fileName, void* loader );
+   static int readStream( void* stream, char* buffer, unsigned int size );
+   static void endStream( void* stream );
+   static int streamError( void* stream, char* message, unsigned int size );
+
+  public:
+   BulkLoader() = delete;
+   BulkLoader( MYSQL* _conn, std::string_view _table, BindsArray<InputCType>& _layout,
+               size_t _chunkBytes = 1024 * 1024, size_t _maxQueued = 4 );
+   BulkLoader( const BulkLoader& ) = delete;
+   BulkLoader& operator=( const BulkLoader& ) = delete;
+   ~BulkLoader();
+
+   // Writes the current values of the layout's selected binds into the stream. Throws
+   // std::runtime_error with the server's error when the load already failed.
+   void addRow();
+   // Ends the stream and waits for the server, returns the rows it loaded. Throws
+   // std::runtime_error when the load failed.
+   unsigned long long finish();
+
+   unsigned long long rowsAdded() const { return added; }
+};
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_BULKLOADER_H
@@ -0,0 +1,50 @@
+#ifndef INCLUDED_COLUMNARENA_H
+#define INCLUDED_COLUMNARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+/*
+    A ColumnArena is one cache-line-aligned block, taken from an upstream std::pmr::memory_resource,
+   that the arena construction mode of BindsArray (makeArenaInputBindsArray() and
+   makeArenaOutputBindsArray() in makeBinds.hpp) places its column objects, their char[] value
+   buffers, the MYSQL_BIND array and its lookup containers in. Allocations are bump allocations
+   that are only given back when the arena is destroyed. If the block was sized too small the
+   remainder spills over to the upstream resource instead of failing.
+*/
+
+namespace set_mysql_binds {
+
+class ColumnArena {
+  public:
+   static constexpr size_t cacheLine = 64;
+
+  private:
+   std::pmr::memory_resource* upstream;
+   size_t blockSize;
+   void* block;
+   std::pmr::monotonic_buffer_resource resource;
+
+  public:
+   ColumnArena() = delete;
+   explicit ColumnArena( size_t bytes,
+                         std::pmr::memory_resource* _upstream = std::pmr::get_default_resource() )
+       : upstream( _upstream ),
+         blockSize( ( bytes + cacheLine - 1 ) & ~( cacheLine - 1 ) ),
+         block( upstream->allocate( blockSize, cacheLine ) ),
+         resource( block, blockSize, upstream ) {}
+   ColumnArena( const ColumnArena& ) = delete;
+   ColumnArena& operator=( const ColumnArena& ) = delete;
+   ~ColumnArena() {
+      resource.release();
+      upstream->deallocate( block, blockSize, cacheLine );
+   }
+
+   void* allocate( size_t bytes, size_t alignment ) { return resource.allocate( bytes, alignment ); }
+   std::pmr::memory_resource* memoryResource() { return &resource; }
+   size_t capacity() const { return blockSize; }
+};
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_COLUMNARENA_H
@@ -0,0 +1,103 @@
+#ifndef INCLUDED_COLUMNARBATCH_H
+#define INCLUDED_COLUMNARBATCH_H
+
+#include <mysql/mysql.h>
+
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BindsArray.hpp"
+#include "SqlTypes/SqlTypes.h"
+#include "Statement.h"
+
+/*
+    A ColumnarBatch gathers up to capacity rows of a result into one contiguous array per column
+   (struct of arrays) instead of one set of column objects per row, for code that works on whole
+   columns such as aggregation loops the compiler can vectorize or column at a time serialization.
+
+    The columns are laid out after the selected binds of the output BindsArray rows are fetched
+   into:
+      fixed width binds (integers, floats, MYSQL_TIME) a typed array of capacity values, values<T>()
+      char[] binds  Arrow style int32 offsets (rows + 1 of them) into one byte buffer, string()
+   Every column also has a validity bitmap, bit i (least significant bit first) of the packed bytes
+   set when row i is not NULL. A NULL row still takes its slot in the value array, zeroed.
+
+    fill() fetches rows through a Statement whose result is bound to that BindsArray, and clear()
+   empties the batch for the next one while keeping its memory.
+*/
+
+namespace set_mysql_binds {
+
+struct ColumnarColumn {
+   std::string name;
+   enum_field_types bufferType;
+   bool isUnsigned;
+   size_t width;  // bytes per value, 0 for char[] columns
+
+   std::vector<unsigned char> fixedValues;  // rows * width bytes
+   std::vector<std::int32_t> offsets;       // char[] columns, rows + 1 entries
+   std::vector<unsigned char> data;         // char[] columns, value bytes
+   std::vector<std::uint8_t> validity;
+   size_t nullCount = 0;
+
+   bool isFixedWidth() const { return width != 0; }
+   bool isValid( size_t row ) const { return ( validity[ row / 8 ] >> ( row % 8 ) ) & 1; }
+
+   template <typename T>
+   std::span<const T> values( size_t rows ) const {
+      if ( sizeof( T ) != width ) {
+         throw std::runtime_error( "ColumnarColumn::values<T>() with T not of the column width\n" );
+      }
+      return { reinterpret_cast<const T*>( fixedValues.data() ), rows };
+   }
+   std::string_view string( size_t row ) const {
+      return { reinterpret_cast<const char*>( data.data() ) + offsets[ row ],
+               static_cast<size_t>( offsets[ row + 1 ] - offsets[ row ] ) };
+   }
+};
+
+class ColumnarBatch {
+  private:
+   BindsArray<OutputCType>& layout;
+   std::vector<ColumnarColumn> columns;
+   size_t capacity;
+   size_t rows;
+
+   void layoutColumns();
+
+  public:
+   ColumnarBatch() = delete;
+   // Columns are those selected in layout when the batch is made, the selection must not change
+   ColumnarBatch( BindsArray<OutputCType>& _layout, size_t _capacity );
+
+   // Appends the row currently in layout's binds, throws std::out_of_range when full and
+   // std::length_error, appending nothing, when a char[] column would pass 2GiB
+   void appendRow();
+   // Fetches rows through statement (whose result is bound to layout) until the batch is full or
+   // the result ends, returns how many were added
+   size_t fill( Statement& statement );
+   void clear();
+   // Moves the column buffers out, to be handed on without a copy, and leaves the batch empty with
+   // newly allocated columns. Only the first size() rows of what is returned are valid.
+   std::vector<ColumnarColumn> takeColumns();
+
+   size_t size() const { return rows; }
+   size_t getCapacity() const { return capacity; }
+   bool full() const { return rows == capacity; }
+   size_t columnCount() const { return columns.size(); }
+   const ColumnarColumn& column( size_t index ) const { return columns.at( index ); }
+   const ColumnarColumn& column( std::string_view name ) const;
+
+   template <typename T>
+   std::span<const T> values( size_t index ) const {
+      return columns.at( index ).values<T>( rows );
+   }
+};
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_COLUMNARBATCH_H
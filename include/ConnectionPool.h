@@ -0,0 +1,129 @@
+#ifndef INCLUDED_CONNECTIONPOOL_H
+#define INCLUDED_CONNECTIONPOOL_H
+
+#include <mysql/mysql.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "StatementCache.h"
+
+/*
+    ConnectionPool keeps up to maxSize open connections to one database and leases them out to
+   threads, so workers do not pay a connect and handshake per unit of work. minSize connections are
+   opened up front by the constructor. A lease returns its connection to the pool when destroyed.
+
+    Each pooled connection carries its own StatementCache, and when a connection is given back it
+   remembers the thread that used it last: lease() hands a thread the connection it had before
+   when that one is idle, keeping that thread's prepared statements warm. A connection that sat
+   idle longer than healthCheckAfter is pinged before being leased out and replaced by a fresh one
+   if the ping fails, as is a connection whose lease was discard()ed.
+
+    initClientLibrary() calls mysql_library_init() once per process, however many pools and
+   threads there are, and arranges for mysql_library_end() at exit. Every thread that opens a
+   connection also gets mysql_thread_end() called for it when it exits.
+*/
+
+namespace set_mysql_binds {
+
+// Throws std::runtime_error if the client library could not be initialized
+void initClientLibrary();
+
+struct ConnectionOptions {
+   std::string host;
+   std::string user;
+   std::string password;
+   std::string database;
+   unsigned int port = 0;
+   std::string unixSocket{};  // empty for TCP
+   bool localInfile = false;  // allows LOAD DATA LOCAL INFILE, which BulkLoader needs
+};
+
+// Opens a connection after initClientLibrary(), throws std::runtime_error on failure
+MYSQL* openConnection( const ConnectionOptions& options );
+
+class ConnectionPool;
+
+struct PooledConnection {
+   MYSQL* mysql;
+   std::unique_ptr<StatementCache> statements;
+   std::chrono::steady_clock::time_point lastUsed;
+   std::thread::id lastOwner;
+};
+
+class ConnectionLease {
+   friend class ConnectionPool;
+
+   ConnectionPool* pool;
+   PooledConnection* connection;
+   bool broken;
+
+   ConnectionLease( ConnectionPool* _pool, PooledConnection* _connection )
+       : pool( _pool ), connection( _connection ), broken( false ) {}
+
+  public:
+   ConnectionLease( const ConnectionLease& ) = delete;
+   ConnectionLease& operator=( const ConnectionLease& ) = delete;
+   ConnectionLease( ConnectionLease&& other ) noexcept;
+   ConnectionLease& operator=( ConnectionLease&& other ) noexcept;
+   ~ConnectionLease();
+
+   MYSQL* get() { return connection->mysql; }
+   StatementCache& statements() { return *connection->statements; }
+   // Marks the connection as unusable (lost, or left in an unknown state) so the pool closes it
+   // instead of leasing it out again
+   void discard() { broken = true; }
+   // Gives the connection back before the lease is destroyed
+   void release();
+};
+
+class ConnectionPool {
+   friend class ConnectionLease;
+
+  private:
+   ConnectionOptions options;
+   size_t maxSize;
+   size_t statementCacheCapacity;
+   std::chrono::milliseconds healthCheckAfter;
+
+   std::mutex mutex;
+   std::condition_variable returned;
+   std::vector<std::unique_ptr<PooledConnection>> idle;
+   size_t open;  // idle, leased and being opened
+
+   std::unique_ptr<PooledConnection> connect();
+   void close( std::unique_ptr<PooledConnection> connection );
+   ConnectionLease leaseIdle( std::unique_lock<std::mutex>& lock );
+   ConnectionLease leaseNew();
+   ConnectionLease checked( std::unique_ptr<PooledConnection> connection );
+   void giveBack( PooledConnection* connection, bool broken );
+
+  public:
+   ConnectionPool() = delete;
+   ConnectionPool( ConnectionOptions _options, size_t _maxSize, size_t minSize = 0,
+                   size_t _statementCacheCapacity = 64,
+                   std::chrono::milliseconds _healthCheckAfter = std::chrono::seconds( 30 ) );
+   ConnectionPool( const ConnectionPool& ) = delete;
+   ConnectionPool& operator=( const ConnectionPool& ) = delete;
+   // Every lease must have been returned before the pool is destroyed
+   ~ConnectionPool();
+
+   // Waits until a connection is idle or a new one may be opened
+   ConnectionLease lease();
+   // As lease() but gives up after timeout
+   std::optional<ConnectionLease> tryLease( std::chrono::milliseconds timeout );
+
+   size_t size();
+   size_t idleCount();
+   size_t getMaxSize() const { return maxSize; }
+};
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_CONNECTIONPOOL_H
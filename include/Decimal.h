@@ -0,0 +1,106 @@
+#ifndef INCLUDED_DECIMAL_H
+#define INCLUDED_DECIMAL_H
+
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "ColumnarBatch.h"
+#include "SqlTypes/SqlTypes.h"
+#include "getDBTables.h"
+
+/*
+    Exact fixed point values for DECIMAL columns, which the binds only know as text (output,
+   BindType<DECIMAL>::outType is char[] MYSQL_TYPE_NEWDECIMAL) or as a double (input). A Decimal
+   holds the value times 10^scale in an int64_t, up to DECIMAL(18), a Decimal128 in an __int128, up
+   to DECIMAL(38), both carrying precision and scale, usually from the schema with decimalFor().
+
+    parseDecimal() and formatDecimal() convert one value from and to the text the server uses,
+   setDecimal() writes a value into a char[] input column through its setText(), the server
+   converts the text to DECIMAL itself. BindType<DECIMAL>::inType is a double, so a DECIMAL
+   column to be written exactly is bound as VARCHAR instead. decodeDecimals() converts a whole
+   ColumnarBatch column, or any batch of texts, of one scale, 16 digits at a time with SSE4.1 (two
+   values per instruction with AVX2), chosen at run time, with a scalar fallback on other CPUs and
+   for text that is not in the server's form. In a column the 16 bytes ending a value are loaded
+   in place, its point shuffled out and the bytes before its digits masked to '0'; other values
+   are first laid out right aligned in a 16 or 32 byte block.
+*/
+
+namespace set_mysql_binds {
+
+using int128 = __int128;
+
+template <typename Rep>
+   requires std::same_as<Rep, std::int64_t> || std::same_as<Rep, int128>
+struct BasicDecimal {
+   static constexpr unsigned int maxPrecision = std::same_as<Rep, std::int64_t> ? 18 : 38;
+
+   Rep unscaled = 0;  // the value times 10^scale
+   unsigned char precision = maxPrecision;
+   unsigned char scale = 0;
+
+   friend bool operator==( const BasicDecimal&, const BasicDecimal& ) = default;
+};
+
+using Decimal = BasicDecimal<std::int64_t>;
+using Decimal128 = BasicDecimal<int128>;
+
+// A zero of the precision and scale of a DECIMAL column, throws std::runtime_error when DecimalT
+// cannot hold the column's precision
+template <typename DecimalT>
+DecimalT decimalFor( const Field& field ) {
+   if ( field.numericPrecision > DecimalT::maxPrecision || field.numericScale > 30 ) {
+      throw std::runtime_error( "DECIMAL column " + field.name + " does not fit " +
+                                std::to_string( DecimalT::maxPrecision ) + " digits\n" );
+   }
+   DecimalT value;
+   if ( field.numericPrecision ) {
+      value.precision = static_cast<unsigned char>( field.numericPrecision );
+   }
+   value.scale = static_cast<unsigned char>( field.numericScale );
+   return value;
+}
+
+// "-0." and 38 digits
+inline constexpr size_t maxDecimalTextSize = 41;
+
+// Reads text into value.unscaled at value.scale (a shorter fraction is padded with zeros). Fails
+// without touching value for text that is not a number, has more fraction digits than the scale or
+// more digits than the precision.
+bool parseDecimal( std::string_view text, Decimal& value );
+bool parseDecimal( std::string_view text, Decimal128& value );
+
+// Writes value as the server does, with exactly scale fraction digits, at out (room for
+// maxDecimalTextSize chars) and returns one past the last char
+char* formatDecimal( char* out, const Decimal& value );
+char* formatDecimal( char* out, const Decimal128& value );
+
+// column.setText() of the formatted value. Throws std::runtime_error when column is not a char[]
+// column, which would not hold the value exactly.
+[[nodiscard]] bool setDecimal( InputCType& column, const Decimal& value );
+[[nodiscard]] bool setDecimal( InputCType& column, const Decimal128& value );
+
+enum class DecimalIsa { Scalar, Sse41, Avx2, Best };
+
+// What DecimalIsa::Best is on this CPU
+DecimalIsa bestDecimalIsa();
+
+// Decodes the texts of rows values of scale into out, NULL rows of a column as 0, with isa or the
+// best one the CPU has below it. Returns rows, or the index of the first row whose text is not a
+// DECIMAL of that scale or does not fit. Throws std::out_of_range when out holds fewer than rows
+// values.
+size_t decodeDecimals( const ColumnarColumn& column, size_t rows, unsigned int scale,
+                       std::span<std::int64_t> out, DecimalIsa isa = DecimalIsa::Best );
+size_t decodeDecimals( const ColumnarColumn& column, size_t rows, unsigned int scale,
+                       std::span<int128> out, DecimalIsa isa = DecimalIsa::Best );
+size_t decodeDecimals( std::span<const std::string_view> texts, unsigned int scale,
+                       std::span<std::int64_t> out, DecimalIsa isa = DecimalIsa::Best );
+size_t decodeDecimals( std::span<const std::string_view> texts, unsigned int scale,
+                       std::span<int128> out, DecimalIsa isa = DecimalIsa::Best );
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_DECIMAL_H
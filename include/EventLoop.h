@@ -0,0 +1,76 @@
+#ifndef INCLUDED_EVENTLOOP_H
+#define INCLUDED_EVENTLOOP_H
+
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+
+#include "Task.hpp"
+
+/*
+    A single threaded epoll event loop for the coroutines of the asynchronous API. Coroutines
+   suspend on waitFor() until their socket is ready, or on schedule() to let others run, and run()
+   resumes them from one thread until every spawned Task has finished. One EventLoop, and the
+   AsyncConnections using it, belong to the thread calling run().
+*/
+
+namespace set_mysql_binds {
+
+class EventLoop {
+  private:
+   int epollFd;
+   std::deque<std::coroutine_handle<>> ready;
+   size_t running;  // spawned tasks not finished yet
+   size_t waiting;  // coroutines suspended in waitFor()
+   std::exception_ptr firstError;
+
+   void watch( int fd, std::uint32_t events, std::coroutine_handle<> handle );
+
+   struct Detached;
+   Detached runDetached( Task<void> task );
+
+  public:
+   struct Scheduled {
+      EventLoop& loop;
+      bool await_ready() const noexcept { return false; }
+      void await_suspend( std::coroutine_handle<> handle ) { loop.ready.push_back( handle ); }
+      void await_resume() const noexcept {}
+   };
+
+   struct SocketReady {
+      EventLoop& loop;
+      int fd;
+      std::uint32_t events;
+      bool await_ready() const noexcept { return false; }
+      void await_suspend( std::coroutine_handle<> handle ) {
+         if ( fd < 0 ) {
+            loop.ready.push_back( handle );
+         } else {
+            loop.watch( fd, events, handle );
+         }
+      }
+      void await_resume() const noexcept {}
+   };
+
+   EventLoop();
+   EventLoop( const EventLoop& ) = delete;
+   EventLoop& operator=( const EventLoop& ) = delete;
+   ~EventLoop();
+
+   // Starts task on the next turn of run(), the loop keeps it alive until it finishes
+   void spawn( Task<void> task );
+   // Runs until every spawned task has finished, then rethrows the first exception a task ended
+   // with, if any
+   void run();
+
+   // Resumes the awaiting coroutine on the next turn of the loop
+   Scheduled schedule() { return { *this }; }
+   // Resumes the awaiting coroutine once fd is ready for events (EPOLLIN, EPOLLOUT), a negative
+   // fd behaves as schedule()
+   SocketReady waitFor( int fd, std::uint32_t events ) { return { *this, fd, events }; }
+};
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_EVENTLOOP_H
@@ -0,0 +1,175 @@
+#ifndef INCLUDED_FIELDHASH_H
+#define INCLUDED_FIELDHASH_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/*
+    FieldHash<N> is a perfect hash over the N column names of a table, built at compile time by
+   the code createDBTableBinds() generates:
+
+      enum class usersColumn : size_t { id, name, email };
+      inline constexpr FieldHash<3> usersFieldHash( std::array<std::string_view, 3>{
+          "id", "name", "email" } );
+
+    find() hashes the name once, reads one displacement and one slot and confirms the match with a
+   single comparison, with no probing and no allocation. Index i is names[ i ], the enumerator of
+   the generated enum with value i. The table is built by hash and displace: names are grouped in
+   buckets by their hash, then each bucket, largest first, gets the first displacement that moves
+   all its names to free slots. Duplicate names are rejected, at compile time when the FieldHash
+   is constexpr.
+
+    BindsArray::useFieldHash() takes the FieldIndex view of a FieldHash for its operator[] by
+   name, the FieldHash has to outlive the BindsArray.
+*/
+
+namespace set_mysql_binds {
+
+// FNV-1a over the name
+constexpr std::uint64_t fieldNameHash( std::string_view name ) {
+   std::uint64_t hash = 14695981039346656037ULL;
+   for ( char c : name ) {
+      hash = ( hash ^ static_cast<unsigned char>( c ) ) * 1099511628211ULL;
+   }
+   return hash;
+}
+
+namespace detail {
+
+// The murmur3 finalizer, FNV-1a alone leaves the high bits of names sharing a prefix alike
+constexpr std::uint64_t mixHash( std::uint64_t hash ) {
+   hash = ( hash ^ ( hash >> 33 ) ) * 0xFF51AFD7ED558CCDULL;
+   hash = ( hash ^ ( hash >> 33 ) ) * 0xC4CEB9FE1A85EC53ULL;
+   return hash ^ ( hash >> 33 );
+}
+
+// Buckets come from the high bits of the mixed hash, slots from the low bits of the mixed hash
+// moved by the bucket's displacement
+constexpr size_t bucketOf( std::uint64_t hash, size_t bucketCount ) {
+   return ( mixHash( hash ) >> 32 ) & ( bucketCount - 1 );
+}
+
+constexpr size_t slotOf( std::uint64_t hash, std::uint64_t displacement, size_t slotCount ) {
+   return mixHash( hash + displacement * 0x9E3779B97F4A7C15ULL ) & ( slotCount - 1 );
+}
+
+}  // namespace detail
+
+// Non-owning view of a FieldHash<N>, whatever N is
+struct FieldIndex {
+   static constexpr size_t npos = static_cast<size_t>( -1 );
+
+   std::span<const std::string_view> names;
+   std::span<const std::uint64_t> hashes;
+   std::span<const std::uint16_t> slots;
+   std::span<const std::uint16_t> displacements;
+
+   constexpr bool empty() const { return names.empty(); }
+
+   // Index of name, npos when it is not one of names. Empty slots hold index 0, which a name
+   // other than names[ 0 ] fails to match like any other.
+   constexpr size_t find( std::string_view name ) const {
+      std::uint64_t hash = fieldNameHash( name );
+      std::uint16_t displacement = displacements[ detail::bucketOf( hash, displacements.size() ) ];
+      size_t index = slots[ detail::slotOf( hash, displacement, slots.size() ) ];
+      return hashes[ index ] == hash && names[ index ] == name ? index : npos;
+   }
+};
+
+template <size_t N>
+class FieldHash {
+   static_assert( N > 0 && N <= 0xFFFF, "FieldHash holds between 1 and 65535 names" );
+
+  public:
+   static constexpr size_t slotCount = std::bit_ceil( N ) * 2;
+   static constexpr size_t bucketCount = std::bit_ceil( ( N + 1 ) / 2 );
+
+   constexpr explicit FieldHash( const std::array<std::string_view, N>& _names ) : names( _names ) {
+      // names sorted by bucket, bucket b holding order[ first[ b ] ] to order[ first[ b + 1 ] ]
+      std::array<size_t, bucketCount + 1> first{};
+      std::array<size_t, N> order{};
+      for ( size_t i = 0; i < N; ++i ) {
+         hashes[ i ] = fieldNameHash( names[ i ] );
+         ++first[ bucketOf( hashes[ i ] ) + 1 ];
+      }
+      size_t largest = 0;
+      for ( size_t b = 0; b < bucketCount; ++b ) {
+         largest = std::max( largest, first[ b + 1 ] );
+         first[ b + 1 ] += first[ b ];
+      }
+      std::array<size_t, bucketCount> filled{};
+      for ( size_t i = 0; i < N; ++i ) {
+         size_t b = bucketOf( hashes[ i ] );
+         order[ first[ b ] + filled[ b ]++ ] = i;
+      }
+
+      std::array<bool, slotCount> used{};
+      for ( size_t size = largest; size > 0; --size ) {
+         for ( size_t b = 0; b < bucketCount; ++b ) {
+            if ( first[ b + 1 ] - first[ b ] == size ) {
+               placeBucket( std::span( order ).subspan( first[ b ], size ), b, used );
+            }
+         }
+      }
+   }
+
+   constexpr FieldIndex index() const { return { names, hashes, slots, displacements }; }
+   constexpr size_t find( std::string_view name ) const { return index().find( name ); }
+   static constexpr size_t size() { return N; }
+
+  private:
+   std::array<std::string_view, N> names;
+   std::array<std::uint64_t, N> hashes{};
+   std::array<std::uint16_t, slotCount> slots{};
+   std::array<std::uint16_t, bucketCount> displacements{};
+
+   static constexpr size_t bucketOf( std::uint64_t hash ) {
+      return detail::bucketOf( hash, bucketCount );
+   }
+   static constexpr size_t slotOf( std::uint64_t hash, std::uint64_t displacement ) {
+      return detail::slotOf( hash, displacement, slotCount );
+   }
+
+   // Finds the first displacement that puts every name of the bucket in a free slot of its own
+   constexpr void placeBucket( std::span<const size_t> bucket, size_t b,
+                               std::array<bool, slotCount>& used ) {
+      for ( size_t i = 0; i < bucket.size(); ++i ) {
+         for ( size_t j = i + 1; j < bucket.size(); ++j ) {
+            if ( hashes[ bucket[ i ] ] == hashes[ bucket[ j ] ] ) {
+               throw std::runtime_error( "FieldHash: duplicate or colliding field name \"" +
+                                         std::string( names[ bucket[ j ] ] ) + "\"\n" );
+            }
+         }
+      }
+      for ( std::uint64_t displacement = 0; displacement <= 0xFFFF; ++displacement ) {
+         bool fits = true;
+         for ( size_t i = 0; i < bucket.size() && fits; ++i ) {
+            size_t slot = slotOf( hashes[ bucket[ i ] ], displacement );
+            fits = !used[ slot ];
+            for ( size_t j = 0; j < i && fits; ++j ) {
+               fits = slot != slotOf( hashes[ bucket[ j ] ], displacement );
+            }
+         }
+         if ( fits ) {
+            displacements[ b ] = static_cast<std::uint16_t>( displacement );
+            for ( size_t i : bucket ) {
+               size_t slot = slotOf( hashes[ i ], displacement );
+               used[ slot ] = true;
+               slots[ slot ] = static_cast<std::uint16_t>( i );
+            }
+            return;
+         }
+      }
+      throw std::runtime_error( "FieldHash: no displacement found for a bucket\n" );
+   }
+};
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_FIELDHASH_H
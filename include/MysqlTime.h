@@ -0,0 +1,150 @@
+#ifndef INCLUDED_MYSQLTIME_H
+#define INCLUDED_MYSQLTIME_H
+
+#include <mysql/mysql.h>
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+
+#include "ColumnarBatch.h"
+
+/*
+    Conversions between the MYSQL_TIME of DATE, DATETIME, TIMESTAMP and TIME binds and std::chrono
+   counts from the epoch (1970-01-01, proleptic Gregorian, no time zone):
+      DATE                 sys_days              toSysDays()    toMysqlDate()
+      DATETIME, TIMESTAMP  sys_microseconds      toSysTime()    toMysqlDateTime()
+      TIME                 chrono::microseconds  toDuration()   toMysqlTime()
+   second_part is kept to the microsecond. The calendar math is Neri and Schneider's: years are
+   moved by 82 eras of 400 years so every year a MYSQL_TIME holds is positive, and the rest is
+   32 bit unsigned multiplies and shifts with no branch and no table. Fields are not checked, a
+   zero date ("0000-00-00") converts to some day before 0000-01-01 rather than failing.
+
+    toEpochValues() converts a whole column of fetched times to int64 counts (days for DATE,
+   microseconds otherwise), fromEpochValues() the other way for input columns.
+*/
+
+namespace set_mysql_binds {
+
+using sys_microseconds = std::chrono::sys_time<std::chrono::microseconds>;
+
+namespace detail {
+
+inline constexpr std::uint32_t civilEras = 82;
+inline constexpr std::uint32_t civilYearShift = 400 * civilEras;
+inline constexpr std::uint32_t civilDayShift = 719468 + 146097 * civilEras;
+inline constexpr std::int64_t microsecondsPerDay = 86400000000LL;
+
+}  // namespace detail
+
+// Days from 1970-01-01 to a date of years 0 to 9999 (and far beyond)
+constexpr std::int32_t daysFromCivil( std::uint32_t year, std::uint32_t month, std::uint32_t day ) {
+   // March based years, January and February count as months 13 and 14 of the year before
+   const std::uint32_t janFeb = month <= 2;
+   const std::uint32_t y = year + detail::civilYearShift - janFeb;
+   const std::uint32_t m = month + 12 * janFeb;
+   const std::uint32_t century = y / 100;
+   const std::uint32_t yearDays = 1461 * y / 4 - century + century / 4;
+   const std::uint32_t monthDays = ( 979 * m - 2919 ) / 32;
+   return static_cast<std::int32_t>( yearDays + monthDays + day - 1 - detail::civilDayShift );
+}
+
+// The date days after 1970-01-01 into time's year, month and day
+constexpr void civilFromDays( std::int32_t days, MYSQL_TIME& time ) {
+   const std::uint32_t n = 4 * ( static_cast<std::uint32_t>( days ) + detail::civilDayShift ) + 3;
+   const std::uint32_t century = n / 146097;
+   const std::uint32_t centuryDays = 4 * ( n % 146097 / 4 ) + 3;
+   const std::uint64_t product = std::uint64_t{ 2939745 } * centuryDays;
+   const std::uint32_t yearOfCentury = static_cast<std::uint32_t>( product >> 32 );
+   const std::uint32_t dayOfYear = static_cast<std::uint32_t>( product ) / 2939745 / 4;
+   const std::uint32_t monthDay = 2141 * dayOfYear + 197913;
+   const std::uint32_t janFeb = dayOfYear >= 306;
+   time.year = 100 * century + yearOfCentury + janFeb - detail::civilYearShift;
+   time.month = ( monthDay >> 16 ) - 12 * janFeb;
+   time.day = ( monthDay & 0xFFFF ) / 2141 + 1;
+}
+
+// hour, minute, second and second_part as a duration, hours beyond 23 included for TIME
+constexpr std::chrono::microseconds clockDuration( const MYSQL_TIME& time ) {
+   return std::chrono::microseconds(
+       ( ( static_cast<std::int64_t>( time.hour ) * 60 + time.minute ) * 60 + time.second ) *
+           1000000 +
+       static_cast<std::int64_t>( time.second_part ) );
+}
+
+constexpr std::chrono::sys_days toSysDays( const MYSQL_TIME& time ) {
+   return std::chrono::sys_days(
+       std::chrono::days( daysFromCivil( time.year, time.month, time.day ) ) );
+}
+
+constexpr sys_microseconds toSysTime( const MYSQL_TIME& time ) {
+   return sys_microseconds( toSysDays( time ) ) + clockDuration( time );
+}
+
+// A TIME value, negative when time.neg is set
+constexpr std::chrono::microseconds toDuration( const MYSQL_TIME& time ) {
+   const std::int64_t magnitude = clockDuration( time ).count();
+   const std::int64_t sign = -static_cast<std::int64_t>( time.neg );
+   return std::chrono::microseconds( ( magnitude ^ sign ) - sign );
+}
+
+namespace detail {
+
+// Splits microseconds of a day, or of a TIME's magnitude, into time's clock fields
+constexpr void setClock( std::uint64_t microseconds, MYSQL_TIME& time ) {
+   const std::uint64_t seconds = microseconds / 1000000;
+   time.second_part = static_cast<unsigned long>( microseconds % 1000000 );
+   time.hour = static_cast<unsigned int>( seconds / 3600 );
+   time.minute = static_cast<unsigned int>( seconds / 60 % 60 );
+   time.second = static_cast<unsigned int>( seconds % 60 );
+}
+
+}  // namespace detail
+
+constexpr MYSQL_TIME toMysqlDate( std::chrono::sys_days date ) {
+   MYSQL_TIME time{};
+   civilFromDays( static_cast<std::int32_t>( date.time_since_epoch().count() ), time );
+   time.time_type = MYSQL_TIMESTAMP_DATE;
+   return time;
+}
+
+constexpr MYSQL_TIME toMysqlDateTime( sys_microseconds point ) {
+   const std::int64_t microseconds = point.time_since_epoch().count();
+   std::int64_t days = microseconds / detail::microsecondsPerDay;
+   std::int64_t ofDay = microseconds % detail::microsecondsPerDay;
+   // floor instead of truncation for points before the epoch
+   const std::int64_t before = ofDay >> 63;
+   days += before;
+   ofDay += before & detail::microsecondsPerDay;
+   MYSQL_TIME time{};
+   civilFromDays( static_cast<std::int32_t>( days ), time );
+   detail::setClock( static_cast<std::uint64_t>( ofDay ), time );
+   time.time_type = MYSQL_TIMESTAMP_DATETIME;
+   return time;
+}
+
+constexpr MYSQL_TIME toMysqlTime( std::chrono::microseconds duration ) {
+   const std::int64_t microseconds = duration.count();
+   const std::int64_t sign = microseconds >> 63;
+   MYSQL_TIME time{};
+   detail::setClock( static_cast<std::uint64_t>( ( microseconds ^ sign ) - sign ), time );
+   time.neg = sign != 0;
+   time.time_type = MYSQL_TIMESTAMP_TIME;
+   return time;
+}
+
+// Converts times of a column of type (DATE, DATETIME, TIMESTAMP or TIME) into out, days for DATE
+// and microseconds otherwise. Throws std::runtime_error for other types and std::out_of_range
+// when out holds fewer values than times.
+void toEpochValues( std::span<const MYSQL_TIME> times, enum_field_types type,
+                    std::span<std::int64_t> out );
+// The first rows values of a ColumnarBatch column, NULL rows as 0
+void toEpochValues( const ColumnarColumn& column, size_t rows, std::span<std::int64_t> out );
+
+// The other way, values counted as toEpochValues() counts them into times
+void fromEpochValues( std::span<const std::int64_t> values, enum_field_types type,
+                      std::span<MYSQL_TIME> times );
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_MYSQLTIME_H
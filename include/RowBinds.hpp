@@ -0,0 +1,85 @@
+#ifndef INCLUDED_ROWBINDS_H
+#define INCLUDED_ROWBINDS_H
+
+#include <mysql/mysql.h>
+
+#include <array>
+#include <concepts>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "makeBinds.hpp"
+
+/*
+    Helpers used by the typed row structs that createDBTableBinds() generates next to the
+   BindsArray factories. Each generated <table>Row is a plain struct of correctly typed members
+   (fixed unsigned char arrays plus a length for char[] columns, a null flag for every column),
+   and its generated bind functions use setRowBind() to point MYSQL_BINDs straight at a struct
+   instance. Direction is InputCType or OutputCType and picks the buffer type the same way
+   BindType<>::inType/outType does for the dynamic columns.
+*/
+
+namespace set_mysql_binds {
+
+template <typename Direction, MysqlInputType Type>
+using RowImpl = std::conditional_t<std::same_as<Direction, InputCType>,
+                                   typename BindType<Type>::inType,
+                                   typename BindType<Type>::outType>;
+
+template <typename Direction, MysqlInputType Type, typename V>
+void setRowBind( MYSQL_BIND& bind, V& value, bool& isNull ) {
+   using Impl = RowImpl<Direction, Type>;
+   static_assert( std::same_as<V, typename Impl::value_type>,
+                  "generated row member type does not match BindType<>" );
+   std::memset( &bind, 0, sizeof( bind ) );
+   bind.buffer_type = Impl::buffer_type;
+   bind.buffer = &value;
+   bind.is_null = &isNull;
+   bind.is_unsigned = std::is_unsigned_v<V>;
+}
+
+template <typename Direction, MysqlInputType Type, size_t N>
+void setRowBind( MYSQL_BIND& bind, unsigned char ( &value )[ N ], unsigned long& length,
+                 bool& isNull ) {
+   using Impl = RowImpl<Direction, Type>;
+   // Only DECIMAL is char[] in a row but not in BindType<>::inType, the server converts strings
+   constexpr enum_field_types bufferType =
+       std::same_as<typename Impl::value_type, std::basic_string<unsigned char>>
+           ? Impl::buffer_type
+           : MYSQL_TYPE_STRING;
+   std::memset( &bind, 0, sizeof( bind ) );
+   bind.buffer_type = bufferType;
+   bind.buffer = value;
+   bind.buffer_length = N;
+   bind.length = &length;
+   bind.is_null = &isNull;
+}
+
+// Fetches up to rows.size() rows of an executed statement straight into rows, re-pointing the
+// result binds at each struct in turn. Returns the number of rows fetched. A truncated char[]
+// value is kept as far as it fits, its _length member holds the full length.
+template <typename Row, size_t Columns>
+size_t fetchRows( MYSQL_STMT* stmt, std::span<Row> rows, void ( *bindRow )( Row&, MYSQL_BIND* ) ) {
+   std::array<MYSQL_BIND, Columns> binds;
+   size_t count = 0;
+   for ( ; count < rows.size(); ++count ) {
+      bindRow( rows[ count ], binds.data() );
+      if ( mysql_stmt_bind_result( stmt, binds.data() ) ) {
+         throw std::runtime_error( mysql_stmt_error( stmt ) );
+      }
+      int status = mysql_stmt_fetch( stmt );
+      if ( status == MYSQL_NO_DATA ) {
+         break;
+      }
+      if ( status == 1 ) {
+         throw std::runtime_error( mysql_stmt_error( stmt ) );
+      }
+   }
+   return count;
+}
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_ROWBINDS_H
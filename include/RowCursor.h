@@ -0,0 +1,100 @@
+#ifndef INCLUDED_ROWCURSOR_H
+#define INCLUDED_ROWCURSOR_H
+
+#include <mysql/mysql.h>
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+
+#include "BindsArray.hpp"
+#include "SqlTypes/SqlTypes.h"
+#include "Statement.h"
+
+/*
+    RowCursor executes a Statement and is an input range over its result, each step fetching the
+   next row into the same BindsArray<OutputCType> buffers, which is what dereferencing yields:
+
+      RowCursor rows( statement, result, { FetchMode::ServerCursor, 1000 } );
+      for ( auto& row : rows ) { ... row[ "id" ] ... }
+
+    How the rows get to the client is chosen with FetchMode:
+      Buffered      the whole result is read into client memory first (mysql_stmt_store_result())
+      Unbuffered    rows are read off the connection one by one as the range is advanced
+      ServerCursor  the server keeps a read only cursor (STMT_ATTR_CURSOR_TYPE) and sends rows in
+                    batches of prefetchRows (STMT_ATTR_PREFETCH_ROWS) as they are asked for
+
+    With Unbuffered and ServerCursor the client holds one row, or one batch of rows, whatever the
+   size of the result, and the server only sends more when the loop asks for more, so a slow
+   consumer holds the producer back instead of growing a buffer. Stopping early (break, close())
+   is cheap with ServerCursor, which just closes the cursor, while an Unbuffered result still has
+   to be read to its end off the connection. Only ServerCursor leaves the connection free for other
+   statements while the scan is in progress.
+*/
+
+namespace set_mysql_binds {
+
+enum class FetchMode { Buffered, Unbuffered, ServerCursor };
+
+struct CursorOptions {
+   FetchMode mode = FetchMode::Unbuffered;
+   unsigned long prefetchRows = 1024;  // ServerCursor only
+};
+
+class RowCursor {
+  private:
+   Statement& statement;
+   BindsArray<OutputCType>& row;
+   CursorOptions options;
+   bool started;
+   bool exhausted;
+   bool closed;
+   unsigned long long fetched;
+
+  public:
+   class iterator {
+      RowCursor* cursor;
+
+     public:
+      using value_type = BindsArray<OutputCType>;
+      using difference_type = std::ptrdiff_t;
+
+      iterator() : cursor( nullptr ) {}
+      explicit iterator( RowCursor* _cursor ) : cursor( _cursor ) {}
+
+      value_type& operator*() const { return cursor->row; }
+      value_type* operator->() const { return &cursor->row; }
+      iterator& operator++() {
+         cursor->next();
+         return *this;
+      }
+      void operator++( int ) { ++*this; }
+      bool operator==( std::default_sentinel_t ) const { return cursor->exhausted; }
+   };
+
+   RowCursor() = delete;
+   // Binds row as the statement's result and executes it, with params bound beforehand through
+   // Statement::bindParams() when it has any. Throws std::runtime_error on failure.
+   RowCursor( Statement& _statement, BindsArray<OutputCType>& _row, CursorOptions _options = {} );
+   RowCursor( const RowCursor& ) = delete;
+   RowCursor& operator=( const RowCursor& ) = delete;
+   ~RowCursor();
+
+   // Fetches the first row, a RowCursor can only be iterated once
+   iterator begin();
+   std::default_sentinel_t end() const { return std::default_sentinel; }
+
+   // Fetches the next row into the BindsArray, false at the end of the result
+   bool next();
+   // Ends the scan early and lets go of the result
+   void close();
+
+   unsigned long long rowsFetched() const { return fetched; }
+   bool done() const { return exhausted; }
+};
+
+static_assert( std::ranges::input_range<RowCursor> );
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_ROWCURSOR_H
@@ -0,0 +1,65 @@
+#ifndef INCLUDED_ROWWRITER_H
+#define INCLUDED_ROWWRITER_H
+
+#include <mysql/mysql.h>
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BindsArray.hpp"
+
+/*
+    A RowWriter appends rows of binds as delimited text to a caller's std::string, to be written
+   out in bulk whenever the caller likes. Values are formatted by SqlTypes/TextFormat.hpp straight
+   into the string, so once it has grown to the size of a flush nothing is allocated per row.
+
+      Csv  RFC 4180: ',' between fields, fields holding ',', '"', CR or LF quoted with '"' doubled,
+           NULL an empty field and the empty string "" so the two read back apart
+      Tsv  the default format of LOAD DATA INFILE and SELECT ... INTO OUTFILE: tab between
+           fields, tab, newline, carriage return, backslash and NUL escaped with a backslash,
+           NULL written \N
+
+   Both end rows with '\n'. The values written are those of the selected binds, in the order of
+   getBinds(), as they are after a fetch or after being set for an insert.
+*/
+
+namespace set_mysql_binds {
+
+enum class RowFormat { Csv, Tsv };
+
+class RowWriter {
+  private:
+   std::string& out;
+   RowFormat format;
+   size_t rows;
+
+   void writeNull();
+   void writeText( std::string_view text );
+
+  public:
+   RowWriter() = delete;
+   RowWriter( std::string& _out, RowFormat _format = RowFormat::Csv );
+
+   void writeHeader( std::span<const std::string_view> names );
+   void writeRow( std::span<const MYSQL_BIND> binds );
+
+   template <typename T>
+   void writeHeader( const BindsArray<T>& row ) {
+      std::vector<std::string_view> names = row.selectedFieldNames();
+      writeHeader( names );
+   }
+   template <typename T>
+   void writeRow( BindsArray<T>& row ) {
+      writeRow( { row.getBinds(), row.getBindsSize() } );
+   }
+
+   // Rows written, the header not counted
+   size_t rowCount() const { return rows; }
+   RowFormat getFormat() const { return format; }
+};
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_ROWWRITER_H
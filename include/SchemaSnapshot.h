@@ -0,0 +1,134 @@
+#ifndef INCLUDED_SCHEMASNAPSHOT_H
+#define INCLUDED_SCHEMASNAPSHOT_H
+
+#include <mysql/mysql.h>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "getDBTables.h"
+
+/*
+    A schema snapshot is the Table/Field data of getDBTables() written once to a binary file that
+   is mmap'ed at startup and read in place, with no parsing. The file is a fixed-width header,
+   then one fixed-width record per table and per field, then a pool of interned strings that the
+   records refer to by offset and length. Numbers are stored in host byte order, a file written
+   on a machine of the other byte order is rejected.
+
+    Each snapshot carries the schema fingerprint it was taken at, see getSchemaFingerprint(), and
+   loadDBTables() only trusts a snapshot whose fingerprint still matches the server's.
+*/
+
+namespace set_mysql_binds {
+
+struct SnapshotHeader {
+   char magic[ 8 ];
+   std::uint32_t byteOrder;
+   std::uint32_t version;
+   std::uint64_t fingerprint;
+   std::uint32_t tableCount;
+   std::uint32_t fieldCount;
+   std::uint64_t tablesOffset;
+   std::uint64_t fieldsOffset;
+   std::uint64_t stringsOffset;
+   std::uint64_t stringsSize;
+};
+
+struct SnapshotTable {
+   std::uint32_t nameOffset;
+   std::uint32_t nameLength;
+   std::uint32_t firstField;
+   std::uint32_t fieldCount;
+};
+
+struct SnapshotField {
+   std::uint32_t nameOffset;
+   std::uint32_t nameLength;
+   std::uint32_t externalTypeOffset;
+   std::uint32_t externalTypeLength;
+   std::uint32_t type;
+   std::uint32_t numericPrecision;
+   std::uint32_t numericScale;
+   std::uint32_t reserved;
+   std::uint64_t flags;
+   std::uint64_t maxLength;
+};
+
+// Views into the mapped file, valid as long as the SchemaSnapshot they came from
+struct FieldView {
+   std::string_view name;
+   enum_field_types type;
+   unsigned long int flags;
+   std::string_view externalType;
+   unsigned long long maxLength;
+   unsigned int numericPrecision;
+   unsigned int numericScale;
+};
+
+class SchemaSnapshot;
+
+class TableView {
+   const SchemaSnapshot* snapshot;
+   const SnapshotTable* record;
+
+  public:
+   TableView( const SchemaSnapshot* _snapshot, const SnapshotTable* _record )
+       : snapshot( _snapshot ), record( _record ) {}
+   std::string_view name() const;
+   size_t fieldCount() const { return record->fieldCount; }
+   FieldView field( size_t index ) const;
+};
+
+class SchemaSnapshot {
+   friend class TableView;
+
+   void* mapping;
+   size_t mappingSize;
+   const SnapshotHeader* header;
+   const SnapshotTable* tableRecords;
+   const SnapshotField* fieldRecords;
+   const char* strings;
+
+   std::string_view string( std::uint32_t offset, std::uint32_t length ) const {
+      return { strings + offset, length };
+   }
+
+  public:
+   // Maps the snapshot at path, isValid() is false when it is missing, truncated, has a record
+   // pointing outside the file or is from another version or byte order
+   explicit SchemaSnapshot( const std::string& path );
+   SchemaSnapshot( const SchemaSnapshot& ) = delete;
+   SchemaSnapshot& operator=( const SchemaSnapshot& ) = delete;
+   ~SchemaSnapshot();
+
+   bool isValid() const { return header != nullptr; }
+   std::uint64_t fingerprint() const { return header->fingerprint; }
+   size_t tableCount() const { return header->tableCount; }
+   TableView table( size_t index ) const { return { this, tableRecords + index }; }
+   // Copies the snapshot out into the form getDBTables() returns
+   std::vector<Table> toTables() const;
+};
+
+// Written to path + ".tmp" and renamed over path so readers never see a partial file
+void writeSchemaSnapshot( const std::string& path, std::span<const Table> tables,
+                          std::uint64_t fingerprint );
+
+// Hash of every column definition of the connection's current database, computed server side so
+// only one row comes back. Changes whenever a table or column is added, dropped or altered,
+// including a change of character set, collation or length that leaves column_type alone.
+std::uint64_t getSchemaFingerprint( MYSQL* db_conn );
+std::uint64_t getSchemaFingerprint( const std::string& host, const std::string& user,
+                                    const std::string& password, const std::string& database );
+
+// getDBTables() through the snapshot at snapshotPath: the snapshot is used when its fingerprint
+// matches the server's, otherwise the schema is introspected and the snapshot rewritten.
+std::vector<Table> loadDBTables( const std::string& host, const std::string& user,
+                                 const std::string& password, const std::string& database,
+                                 const std::string& snapshotPath );
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_SCHEMASNAPSHOT_H
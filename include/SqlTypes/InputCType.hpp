@@ -4,27 +4,137 @@
 #include <iostream>
 
 #include "SqlTypes/SqlCType.h"
+#include "SqlTypes/TextFormat.hpp"
+#include "SqlTypes/TextParse.hpp"
 
 namespace set_mysql_binds {
 
 using enum MysqlInputType;
 
+// Checking policies of the typed InputCType::set() writes, BindsArray<InputCType, Checking> picks
+// one for all its columns. None of them reads strict_fundamental_type_checking.
+//    StrictChecking     only arguments that convert to the column's C type without narrowing
+//                       compile, the column is checked to hold that C type (one compare)
+//    NarrowingChecking  any arithmetic argument is static_cast to the C type, the column is
+//                       checked as with StrictChecking
+//    NoChecking         static_cast and no check of the column, for column IDs known to match
+struct StrictChecking {
+   static constexpr bool allowNarrowing = false;
+   static constexpr bool checkColumn = true;
+};
+struct NarrowingChecking {
+   static constexpr bool allowNarrowing = true;
+   static constexpr bool checkColumn = true;
+};
+struct NoChecking {
+   static constexpr bool allowNarrowing = true;
+   static constexpr bool checkColumn = false;
+};
+
+template <typename V, typename T>
+concept NonNarrowingTo = requires( V newValue ) { T{ newValue }; };
+
 class InputCType : public SqlCType {
+   // the column's own buffer while a caller's buffer is borrowed
+   void* ownedBuffer;
+   unsigned long long ownedBufferLength;
+
   public:
    InputCType( std::string_view _fieldName, enum_field_types type, void* _buffer,
-               unsigned long long _bufferLength = 0 )
-       : SqlCType( _fieldName, type, _buffer, _bufferLength ) {}
+               unsigned long long _bufferLength = 0, bool _isUnsigned = false )
+       : SqlCType( _fieldName, type, _buffer, _bufferLength, _isUnsigned ),
+         ownedBuffer( nullptr ),
+         ownedBufferLength( 0 ) {}
    virtual ~InputCType() = default;
    InputCType& operator=( const InputCType& ) = delete;
    virtual void operator=( long double newValue ) = 0;
    virtual void operator=( const std::string& newValue ) = 0;
    virtual void operator=( std::span<const unsigned char> newValue ) = 0;
    virtual void operator=( const MYSQL_TIME& newValue ) = 0;
+   // Sets the value from its text without throwing, for feeds of text fields such as CSV. Numbers
+   // are read with std::from_chars (no locale, no leading spaces, the whole text must be a value in
+   // range of the column type, 0 or 1 for BOOLEAN), temporal columns take the forms of
+   // parseTime(), char[] columns the text as it is. Empty text sets NULL. Returns false, with the
+   // value left as it was, when the text is not a value of the column or does not fit its buffer.
+   [[nodiscard]] virtual bool setText( std::string_view text ) = 0;
+
+   // Borrowed buffer mode for char[] columns: the bind points straight at data instead of data
+   // being copied into the column's buffer. data must stay valid until the statement has been
+   // executed. borrow() and release() point every bind array of the owning BindsArray, selection
+   // and projections, at the buffer and move its getBindsVersion(), so a Statement binds the
+   // params again. Assigning a value releases the borrowed buffer.
+   void borrow( std::span<const unsigned char> data ) {
+      if ( !isCharArray( bufferType ) ) {
+         throw std::runtime_error( "borrow() is only available for char[] columns\n" );
+      }
+      if ( !ownedBuffer ) {
+         ownedBuffer = buffer;
+         ownedBufferLength = bufferLength;
+      }
+      buffer = const_cast<unsigned char*>( data.data() );
+      bufferLength = data.size();
+      length = data.size();
+      isNull = false;
+      bufferMoved();
+   }
+   void borrow( std::string_view data ) {
+      borrow( std::span<const unsigned char>(
+          reinterpret_cast<const unsigned char*>( data.data() ), data.size() ) );
+   }
+   // Goes back to the column's own buffer, its previous value is gone
+   void release() {
+      if ( ownedBuffer ) {
+         buffer = ownedBuffer;
+         bufferLength = ownedBufferLength;
+         length = 0;
+         ownedBuffer = nullptr;
+         bufferMoved();
+      }
+   }
+   bool isBorrowed() const { return ownedBuffer != nullptr; }
+   // Size of the column's own buffer, whether or not one is borrowed
+   unsigned long long ownBufferLength() const {
+      return ownedBuffer ? ownedBufferLength : bufferLength;
+   }
 
    template <MysqlInputType type>
    auto& Value() {
       return *static_cast<ValType<type>::type*>( buffer );
    }
+
+   // Typed writes of fixed size columns, inlined and without the long double round trip of
+   // operator=. set<INT>( v ) writes the C type of the MysqlInputType, set<int>( v ) the C type
+   // itself, Checking decides which arguments compile and whether the column's type is checked. A
+   // column that does not hold the C type throws std::runtime_error and keeps its value.
+   template <MysqlInputType type, typename Checking = StrictChecking, typename V>
+   void set( V newValue ) {
+      static_assert( !std::same_as<typename ValType<type>::type, unsigned char> ||
+                         type == TINYINT_UNSIGNED,
+                     "char[] columns are set with setText() or operator=" );
+      set<typename ValType<type>::type, Checking>( newValue );
+   }
+   template <ApprovedType T, typename Checking = StrictChecking, typename V>
+   void set( V newValue ) {
+      static_assert( !std::same_as<T, std::basic_string<unsigned char>>,
+                     "char[] columns are set with setText() or operator=" );
+      if constexpr ( std::same_as<T, MYSQL_TIME> ) {
+         static_assert( std::same_as<V, MYSQL_TIME>, "temporal columns are set from MYSQL_TIME" );
+      } else if constexpr ( Checking::allowNarrowing ) {
+         static_assert( std::is_arithmetic_v<V>, "numeric columns are set from numbers" );
+      } else {
+         static_assert( std::is_arithmetic_v<V> && NonNarrowingTo<V, T>,
+                        "StrictChecking: the value does not convert to the column's C type "
+                        "without narrowing" );
+      }
+      if constexpr ( Checking::checkColumn ) {
+         if ( !holds<T>() ) {
+            throw std::runtime_error( std::string( fieldName ) +
+                                      ": set() type does not match the column\n" );
+         }
+      }
+      *static_cast<T*>( buffer ) = static_cast<T>( newValue );
+      isNull = false;
+   }
 };
 
 // The original idea for these templates from reddit user u/IyeOnline
@@ -35,14 +145,26 @@ class InImpl : public InputCType {
    T value;
 
   public:
+   using value_type = T;
+   static constexpr enum_field_types buffer_type =
+       ( Type == MYSQL_TYPE_BOOL ? MYSQL_TYPE_TINY : Type );
+
    InImpl() = delete;
-   InImpl( std::string_view _fieldName, unsigned long long _bufferLength = 0 )
+   // For char[] columns _externalBuffer, when given, is used as the value buffer instead of value
+   // (ColumnArena construction), it must hold _bufferLength bytes and outlive the column.
+   InImpl( std::string_view _fieldName, unsigned long long _bufferLength = 0,
+           unsigned char* _externalBuffer = nullptr )
        : InputCType( _fieldName, ( Type == MYSQL_TYPE_BOOL ? MYSQL_TYPE_TINY : Type ),
                      ( std::same_as<T, std::basic_string<unsigned char>> ? nullptr : &value ),
-                     _bufferLength ) {
+                     _bufferLength, std::is_unsigned_v<T> ) {
       if constexpr ( std::same_as<T, std::basic_string<unsigned char>> ) {
-         value.resize( _bufferLength, '\0' );
-         buffer = value.data();
+         if ( _externalBuffer ) {
+            std::memset( _externalBuffer, 0, _bufferLength );
+            buffer = _externalBuffer;
+         } else {
+            value.resize( _bufferLength, '\0' );
+            buffer = value.data();
+         }
       }
       if constexpr ( std::same_as<T, MYSQL_TIME> ) {
          std::memset( &value, 0, sizeof( value ) );
@@ -63,26 +185,49 @@ class InImpl : public InputCType {
       }
    }
    void operator=( const std::string& newValue ) override {
-      if ( !newValue.length() ) {
+      if ( !setText( newValue ) ) {
+         throw std::runtime_error( "\"" + newValue + "\" is not a value of " +
+                                   std::string( fieldName ) + '\n' );
+      }
+   }
+   bool setText( std::string_view text ) override {
+      if ( text.empty() ) {
          isNull = true;
-         return;
+         return true;
       }
       if constexpr ( std::same_as<T, std::basic_string<unsigned char>> ) {
-         std::copy( newValue.begin(), newValue.end(), value.begin() );
-         length = newValue.size();
-      } else if constexpr ( std::integral<T> ) {
-         value = std::stol( newValue );
-      } else if constexpr ( std::same_as<T, float> ) {
-         value = std::stof( newValue );
-      } else if constexpr ( std::same_as<T, double> ) {
-         value = std::stod( newValue );
+         if ( text.size() > ownBufferLength() ) {
+            return false;
+         }
+         release();
+         std::memcpy( buffer, text.data(), text.size() );
+         length = text.size();
+      } else if constexpr ( std::same_as<T, MYSQL_TIME> ) {
+         MYSQL_TIME parsed;
+         if ( !parseTime( text, parsed ) ) {
+            return false;
+         }
+         value = parsed;
+      } else if constexpr ( Type == MYSQL_TYPE_BOOL ) {
+         signed char parsed;
+         if ( !parseNumber( text, parsed ) || parsed < 0 || parsed > 1 ) {
+            return false;
+         }
+         value = parsed;
       } else {
-         throw std::runtime_error( mismatch );
+         T parsed;
+         if ( !parseNumber( text, parsed ) ) {
+            return false;
+         }
+         value = parsed;
       }
+      isNull = false;
+      return true;
    }
    void operator=( std::span<const unsigned char> newValue ) override {
       if constexpr ( std::same_as<T, std::basic_string<unsigned char>> ) {
-         std::copy( newValue.begin(), newValue.end(), value.begin() );
+         release();
+         std::copy( newValue.begin(), newValue.end(), static_cast<unsigned char*>( buffer ) );
          length = newValue.size();
       } else {
          throw std::runtime_error( mismatch );
@@ -96,23 +241,22 @@ class InImpl : public InputCType {
       }
    }
    std::ostream& print_value( std::ostream& os ) const override {
-      os << std::boolalpha << std::setprecision( 15 );
       if ( isNull ) {
          os << "NULL";
       } else if constexpr ( std::same_as<T, std::basic_string<unsigned char>> ) {
-         std::copy( value.begin(), value.end(), std::ostream_iterator<unsigned char>{ os } );
-      } else if constexpr ( Type == MYSQL_TYPE_TINY ) {
-         os << static_cast<int>( value );
+         os.write( static_cast<const char*>( buffer ),
+                   static_cast<std::streamsize>( bufferLength ) );
       } else if constexpr ( Type == MYSQL_TYPE_BOOL ) {
-         os << static_cast<bool>( value );
-      } else if constexpr ( std::same_as<T, MYSQL_TIME> ) {
-         os << value.year << "-" << ( value.month > 9 ? "" : "0" ) << std::to_string( value.month )
-            << "-" << ( value.day > 9 ? "" : "0" ) << std::to_string( value.day ) << " "
-            << ( value.hour > 9 ? "" : "0" ) << std::to_string( value.hour ) << ":"
-            << ( value.minute > 9 ? "" : "0" ) << std::to_string( value.minute ) << ":"
-            << ( value.second > 9 ? "" : "0" ) << std::to_string( value.second );
+         os << ( value ? "true" : "false" );
       } else {
-         os << value;
+         char text[ maxFixedTextSize ];
+         char* end;
+         if constexpr ( std::same_as<T, MYSQL_TIME> ) {
+            end = formatTime( text, value, Type );
+         } else {
+            end = formatNumber( text, value );
+         }
+         os.write( text, end - text );
       }
       return os;
    }
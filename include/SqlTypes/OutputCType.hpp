@@ -6,15 +6,20 @@
 #include <sstream>
 
 #include "SqlTypes/SqlCType.h"
+#include "SqlTypes/TextFormat.hpp"
 
 namespace set_mysql_binds {
 class OutputCType : public SqlCType {
   public:
    OutputCType( std::string_view _fieldName, enum_field_types type, void* _buffer,
-                unsigned long long _bufferLength = 0 )
-       : SqlCType( _fieldName, type, _buffer, _bufferLength ) {}
+                unsigned long long _bufferLength = 0, bool _isUnsigned = false )
+       : SqlCType( _fieldName, type, _buffer, _bufferLength, _isUnsigned ) {}
    virtual ~OutputCType() = default;
 
+   // Grows a char[] value buffer to newLength bytes so a truncated value can be fetched again,
+   // returns false for fixed width columns.
+   virtual bool growBuffer( unsigned long newLength ) = 0;
+
    template <MysqlInputType type>
    const auto* Value() {
       if constexpr ( type == DECIMAL ) {
@@ -30,45 +35,64 @@ class OutImpl : public OutputCType {
    T value;
 
   public:
+   using value_type = T;
+   static constexpr enum_field_types buffer_type =
+       ( Type == MYSQL_TYPE_BOOL ? MYSQL_TYPE_TINY : Type );
+
    OutImpl() = delete;
-   OutImpl( std::string_view _fieldName, unsigned long long _bufferLength = 0 )
+   // For char[] columns _externalBuffer, when given, is used as the value buffer instead of value
+   // (ColumnArena construction), it must hold _bufferLength bytes and outlive the column.
+   OutImpl( std::string_view _fieldName, unsigned long long _bufferLength = 0,
+            unsigned char* _externalBuffer = nullptr )
        : OutputCType( _fieldName, ( Type == MYSQL_TYPE_BOOL ? MYSQL_TYPE_TINY : Type ),
                       ( std::same_as<T, std::basic_string<unsigned char>> ? nullptr : &value ),
-                      _bufferLength ) {
+                      _bufferLength, std::is_unsigned_v<T> ) {
+      if constexpr ( std::same_as<T, std::basic_string<unsigned char>> ) {
+         if ( _externalBuffer ) {
+            std::memset( _externalBuffer, 0, _bufferLength );
+            buffer = _externalBuffer;
+         } else {
+            value.resize( _bufferLength, '\0' );
+            buffer = value.data();
+         }
+      }
+   }
+
+   bool growBuffer( unsigned long newLength ) override {
       if constexpr ( std::same_as<T, std::basic_string<unsigned char>> ) {
-         value.resize( _bufferLength, '\0' );
-         buffer = value.data();
+         if ( newLength > bufferLength ) {
+            // an arena provided buffer is left behind, value owns the buffer from now on
+            value.resize( newLength, '\0' );
+            buffer = value.data();
+            bufferLength = newLength;
+         }
+         return true;
+      } else {
+         return false;
       }
    }
 
    std::ostream& print_value( std::ostream& os ) const override {
-      os << std::boolalpha << std::setprecision( 15 );
       if ( isNull ) {
          os << "NULL";
       } else if constexpr ( std::same_as<T, std::basic_string<unsigned char>> ) {
-         if ( value.size() ) {
-            std::string out;
-            out.reserve( length );
-            std::copy( value.begin(), std::next( value.begin(), length ),
-                       std::back_inserter( out ) );
-            os << out;
+         if ( bufferLength ) {
+            std::string_view out = view();
+            os.write( out.data(), static_cast<std::streamsize>( out.size() ) );
          } else {
             os << "NULL";
          }
-      } else if constexpr ( Type == MYSQL_TYPE_TINY ) {
-         os << static_cast<int>( value );
       } else if constexpr ( Type == MYSQL_TYPE_BOOL ) {
-         os << static_cast<bool>( value );
-      } else if constexpr ( std::same_as<T, MYSQL_TIME> ) {
-         std::ostringstream _os;
-         _os << value.year << "-" << ( value.month > 9 ? "" : "0" ) << std::to_string( value.month )
-             << "-" << ( value.day > 9 ? "" : "0" ) << std::to_string( value.day ) << " "
-             << ( value.hour > 9 ? "" : "0" ) << std::to_string( value.hour ) << ":"
-             << ( value.minute > 9 ? "" : "0" ) << std::to_string( value.minute ) << ":"
-             << ( value.second > 9 ? "" : "0" ) << std::to_string( value.second );
-         os << std::move( _os.str() );
+         os << ( value ? "true" : "false" );
       } else {
-         os << value;
+         char text[ maxFixedTextSize ];
+         char* end;
+         if constexpr ( std::same_as<T, MYSQL_TIME> ) {
+            end = formatTime( text, value, Type );
+         } else {
+            end = formatNumber( text, value );
+         }
+         os.write( text, end - text );
       }
       return os;
    }
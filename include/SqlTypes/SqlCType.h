@@ -4,6 +4,7 @@
 #include <mysql/mysql.h>
 
 #include <algorithm>
+#include <concepts>
 #include <cstring>
 #include <iomanip>
 #include <iterator>
@@ -30,6 +31,18 @@
 
 namespace set_mysql_binds {
 
+class SqlCType;
+
+// The BindsArray a column belongs to, told when the column's buffer moved so that every
+// MYSQL_BIND it made for the column points at the new one
+class BindsOwner {
+  public:
+   virtual void bufferMoved( SqlCType& column ) = 0;
+
+  protected:
+   ~BindsOwner() = default;
+};
+
 class SqlCType {
   public:
    const std::string_view fieldName;
@@ -38,31 +51,94 @@ class SqlCType {
    bool error;
    unsigned long length;
    MYSQL_BIND* bind;
+   BindsOwner* owner;  // set by the BindsArray holding the column
    void* buffer;
    unsigned long long bufferLength;
    bool is_selected;
+   const bool isUnsigned;  // value is an unsigned integer, sets MYSQL_BIND::is_unsigned
 
    SqlCType( std::string_view _fieldName, enum_field_types type, void* _buffer,
-             unsigned long long _bufferLength = 0 )
+             unsigned long long _bufferLength = 0, bool _isUnsigned = false )
        : fieldName( _fieldName ),
          bufferType( type ),
          isNull( 0 ),
          error( 0 ),
          length( 0 ),
          bind( nullptr ),
+         owner( nullptr ),
          buffer( _buffer ),
          bufferLength( _bufferLength ),
-         is_selected( true ) {}
+         is_selected( true ),
+         isUnsigned( _isUnsigned ) {}
 
    void setBind( MYSQL_BIND* targetBind ) {
       bind = targetBind;
-      std::memset( bind, 0, sizeof( *bind ) );
-      bind->buffer_type = bufferType;
-      bind->buffer = (char*)buffer;
-      bind->is_null = &isNull;
-      bind->length = &length;
-      bind->error = &error;
-      bind->buffer_length = bufferLength;
+      fillBind( targetBind );
+   }
+
+   // After buffer or bufferLength changed, points the binds of the column at them
+   void bufferMoved() {
+      if ( owner ) {
+         owner->bufferMoved( *this );
+      } else if ( bind ) {
+         fillBind( bind );
+      }
+   }
+   // Points targetBind at this column without making it the column's bind
+   void fillBind( MYSQL_BIND* targetBind ) {
+      std::memset( targetBind, 0, sizeof( *targetBind ) );
+      targetBind->buffer_type = bufferType;
+      targetBind->buffer = (char*)buffer;
+      targetBind->is_null = &isNull;
+      targetBind->length = &length;
+      targetBind->error = &error;
+      targetBind->buffer_length = bufferLength;
+      targetBind->is_unsigned = isUnsigned;
+   }
+
+   // Views of a char[] column's current value sized by length, nothing is copied. They are valid
+   // until the buffer is written again (next fetch or assignment).
+   std::string_view view() const {
+      return { static_cast<const char*>( buffer ),
+               std::min<unsigned long long>( length, bufferLength ) };
+   }
+   std::span<const unsigned char> bytes() const {
+      return { static_cast<const unsigned char*>( buffer ),
+               std::min<unsigned long long>( length, bufferLength ) };
+   }
+
+   // Whether the column's value is a T, judged from bufferType and isUnsigned
+   template <typename T>
+   bool holds() const {
+      if constexpr ( std::same_as<T, MYSQL_TIME> ) {
+         return bufferType == MYSQL_TYPE_DATE || bufferType == MYSQL_TYPE_TIME ||
+                bufferType == MYSQL_TYPE_DATETIME || bufferType == MYSQL_TYPE_TIMESTAMP;
+      } else if constexpr ( std::same_as<T, float> ) {
+         return bufferType == MYSQL_TYPE_FLOAT;
+      } else if constexpr ( std::same_as<T, double> ) {
+         return bufferType == MYSQL_TYPE_DOUBLE;
+      } else if constexpr ( std::integral<T> ) {
+         if ( isUnsigned != std::is_unsigned_v<T> ) {
+            return false;
+         }
+         switch ( bufferType ) {
+            case MYSQL_TYPE_TINY:
+               return sizeof( T ) == sizeof( signed char );
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_YEAR:
+               return sizeof( T ) == sizeof( short );
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_INT24:
+               return sizeof( T ) == sizeof( int );
+            case MYSQL_TYPE_LONGLONG:
+            case MYSQL_TYPE_BIT:
+               return sizeof( T ) == sizeof( long );
+            default:
+               return false;
+         }
+      } else {
+         return false;
+      }
    }
 
    virtual ~SqlCType() = default;
@@ -0,0 +1,161 @@
+#ifndef INCLUDED_TEXTFORMAT_H
+#define INCLUDED_TEXTFORMAT_H
+
+#include <mysql/mysql.h>
+
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <type_traits>
+
+#include "utilities.h"
+
+/*
+    Conversions from the C values the binds hold to text, the other direction of TextParse.hpp.
+   Everything appends at a caller provided char pointer and returns one past the last char
+   written: numbers go through std::to_chars (integers exactly, floating point as the shortest
+   text that reads back to the same value) and temporal values are written two digits at a time
+   from a table. Nothing allocates, touches a locale or throws.
+
+    The caller guarantees room for maxFixedTextSize chars, enough for any fixed width value:
+      DATE        YYYY-MM-DD
+      TIME        [-]hh[h]:mm:ss[.ffffff]
+      DATETIME    YYYY-MM-DD hh:mm:ss[.ffffff]   (TIMESTAMP as well)
+   Fractional seconds are written when second_part is not 0.
+*/
+
+namespace set_mysql_binds {
+
+// "-2.2250738585072014e-308" is 24 chars, "-838:59:59.999999" 17, a DATETIME 26
+inline constexpr size_t maxFixedTextSize = 32;
+
+namespace detail {
+
+inline constexpr std::array<char, 200> digitPairs = [] {
+   std::array<char, 200> pairs{};
+   for ( int i = 0; i < 100; ++i ) {
+      pairs[ static_cast<size_t>( 2 * i ) ] = static_cast<char>( '0' + i / 10 );
+      pairs[ static_cast<size_t>( 2 * i + 1 ) ] = static_cast<char>( '0' + i % 10 );
+   }
+   return pairs;
+}();
+
+// value % 100 as two digits
+inline char* writeTwoDigits( char* out, unsigned int value ) {
+   std::memcpy( out, &digitPairs[ 2 * ( value % 100 ) ], 2 );
+   return out + 2;
+}
+
+}  // namespace detail
+
+template <typename T>
+   requires std::is_arithmetic_v<T>
+char* formatNumber( char* out, T value ) {
+   if constexpr ( std::is_same_v<T, bool> ) {
+      *out = value ? '1' : '0';
+      return out + 1;
+   } else {
+      return std::to_chars( out, out + maxFixedTextSize, value ).ptr;
+   }
+}
+
+// "YYYY-MM-DD"
+inline char* formatDate( char* out, const MYSQL_TIME& time ) {
+   out = detail::writeTwoDigits( out, time.year / 100 );
+   out = detail::writeTwoDigits( out, time.year );
+   *out++ = '-';
+   out = detail::writeTwoDigits( out, time.month );
+   *out++ = '-';
+   return detail::writeTwoDigits( out, time.day );
+}
+
+// "hh:mm:ss[.ffffff]", hours of a TIME value can take three digits
+inline char* formatClock( char* out, const MYSQL_TIME& time ) {
+   if ( time.hour >= 100 ) {
+      *out++ = static_cast<char>( '0' + time.hour / 100 % 10 );
+   }
+   out = detail::writeTwoDigits( out, time.hour );
+   *out++ = ':';
+   out = detail::writeTwoDigits( out, time.minute );
+   *out++ = ':';
+   out = detail::writeTwoDigits( out, time.second );
+   if ( time.second_part ) {
+      auto fraction = static_cast<unsigned int>( time.second_part % 1000000 );
+      *out++ = '.';
+      out = detail::writeTwoDigits( out, fraction / 10000 );
+      out = detail::writeTwoDigits( out, fraction / 100 );
+      out = detail::writeTwoDigits( out, fraction );
+   }
+   return out;
+}
+
+// The text of time as a value of the column type, time.time_type is not looked at as values
+// assigned by hand seldom set it
+inline char* formatTime( char* out, const MYSQL_TIME& time, enum_field_types type ) {
+   switch ( type ) {
+      case MYSQL_TYPE_DATE:
+         return formatDate( out, time );
+      case MYSQL_TYPE_TIME:
+         if ( time.neg ) {
+            *out++ = '-';
+         }
+         return formatClock( out, time );
+      default:
+         out = formatDate( out, time );
+         *out++ = ' ';
+         return formatClock( out, time );
+   }
+}
+
+namespace detail {
+
+// Integers are read with the signedness of the bind, as the server would
+template <typename Signed>
+char* formatInteger( char* out, const void* buffer, bool isUnsigned ) {
+   if ( isUnsigned ) {
+      std::make_unsigned_t<Signed> value;
+      std::memcpy( &value, buffer, sizeof( value ) );
+      return formatNumber( out, value );
+   }
+   Signed value;
+   std::memcpy( &value, buffer, sizeof( value ) );
+   return formatNumber( out, value );
+}
+
+}  // namespace detail
+
+// Writes the text of a fixed width bind's value and returns one past its end. char[] binds are
+// their own text and write nothing, NULL is left to the caller as its spelling depends on the
+// output format.
+inline char* bindToText( char* out, const MYSQL_BIND& bind ) {
+   switch ( bind.buffer_type ) {
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_BOOL:
+         return detail::formatInteger<signed char>( out, bind.buffer, bind.is_unsigned );
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_YEAR:
+         return detail::formatInteger<short>( out, bind.buffer, bind.is_unsigned );
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_INT24:
+         return detail::formatInteger<int>( out, bind.buffer, bind.is_unsigned );
+      case MYSQL_TYPE_LONGLONG:
+         return detail::formatInteger<long long>( out, bind.buffer, bind.is_unsigned );
+      case MYSQL_TYPE_BIT:
+         return detail::formatInteger<long long>( out, bind.buffer, true );
+      case MYSQL_TYPE_FLOAT:
+         return formatNumber( out, *static_cast<const float*>( bind.buffer ) );
+      case MYSQL_TYPE_DOUBLE:
+         return formatNumber( out, *static_cast<const double*>( bind.buffer ) );
+      case MYSQL_TYPE_DATE:
+      case MYSQL_TYPE_TIME:
+      case MYSQL_TYPE_DATETIME:
+      case MYSQL_TYPE_TIMESTAMP:
+         return formatTime( out, *static_cast<const MYSQL_TIME*>( bind.buffer ), bind.buffer_type );
+      default:
+         return out;
+   }
+}
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_TEXTFORMAT_H
@@ -0,0 +1,234 @@
+#ifndef INCLUDED_TEXTPARSE_H
+#define INCLUDED_TEXTPARSE_H
+
+#include <mysql/mysql.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "utilities.h"
+
+/*
+    Conversions from the text MySQL uses for values (text protocol rows, user input) to the C
+   values the binds hold. Nothing here throws or allocates: numbers go through std::from_chars and
+   temporal values are parsed by hand, every function reports failure through its return value.
+
+    textToBind() writes one text value into whatever a MYSQL_BIND points at, the way
+   mysql_stmt_fetch() would have written the binary protocol value, so text protocol results can
+   land in the same BindsArray<OutputCType> buffers as prepared statement results.
+*/
+
+namespace set_mysql_binds {
+
+// The whole of text must be the number, a value out of the range of T fails. std::from_chars takes
+// no '+', one is skipped unless a sign follows it.
+template <typename T>
+   requires std::is_arithmetic_v<T>
+bool parseNumber( std::string_view text, T& value ) {
+   if ( text.size() > 1 && text[ 0 ] == '+' && text[ 1 ] != '-' && text[ 1 ] != '+' ) {
+      text.remove_prefix( 1 );
+   }
+   const char* end = text.data() + text.size();
+   auto [ ptr, ec ] = std::from_chars( text.data(), end, value );
+   return ec == std::errc() && ptr == end;
+}
+
+// Exactly count digits from the front of text
+inline bool parseDigits( std::string_view& text, size_t count, unsigned int& value ) {
+   if ( text.size() < count ) {
+      return false;
+   }
+   value = 0;
+   for ( size_t i = 0; i < count; ++i ) {
+      if ( text[ i ] < '0' || text[ i ] > '9' ) {
+         return false;
+      }
+      value = value * 10 + static_cast<unsigned int>( text[ i ] - '0' );
+   }
+   text.remove_prefix( count );
+   return true;
+}
+
+inline bool parseSeparator( std::string_view& text, char separator ) {
+   if ( text.empty() || text.front() != separator ) {
+      return false;
+   }
+   text.remove_prefix( 1 );
+   return true;
+}
+
+// ".f" up to ".ffffff", scaled to microseconds
+inline bool parseFraction( std::string_view& text, unsigned long& microseconds ) {
+   microseconds = 0;
+   if ( text.empty() || text.front() != '.' ) {
+      return true;
+   }
+   text.remove_prefix( 1 );
+   size_t digits = 0;
+   for ( ; digits < text.size() && text[ digits ] >= '0' && text[ digits ] <= '9'; ++digits ) {
+      if ( digits < 6 ) {
+         microseconds = microseconds * 10 + static_cast<unsigned long>( text[ digits ] - '0' );
+      }
+   }
+   if ( !digits ) {
+      return false;
+   }
+   for ( size_t i = digits; i < 6; ++i ) {
+      microseconds *= 10;
+   }
+   text.remove_prefix( digits );
+   return true;
+}
+
+// "YYYY-MM-DD", "YYYY-MM-DD hh:mm:ss[.ffffff]" (ISO 8601 'T' separator accepted) or the TIME form
+// "[-]h[hh]:mm:ss[.ffffff]". Field ranges are checked, the calendar is not (as with MySQL's own
+// zero dates, "0000-00-00" is accepted).
+inline bool parseTime( std::string_view text, MYSQL_TIME& time ) {
+   std::memset( &time, 0, sizeof( time ) );
+   if ( text.size() >= 10 && text[ 4 ] == '-' ) {
+      if ( !parseDigits( text, 4, time.year ) || !parseSeparator( text, '-' ) ||
+           !parseDigits( text, 2, time.month ) || !parseSeparator( text, '-' ) ||
+           !parseDigits( text, 2, time.day ) || time.month > 12 || time.day > 31 ) {
+         return false;
+      }
+      if ( text.empty() ) {
+         time.time_type = MYSQL_TIMESTAMP_DATE;
+         return true;
+      }
+      if ( text.front() != ' ' && text.front() != 'T' ) {
+         return false;
+      }
+      text.remove_prefix( 1 );
+      time.time_type = MYSQL_TIMESTAMP_DATETIME;
+      if ( !parseDigits( text, 2, time.hour ) || time.hour > 23 ) {
+         return false;
+      }
+   } else {
+      time.time_type = MYSQL_TIMESTAMP_TIME;
+      if ( !text.empty() && text.front() == '-' ) {
+         time.neg = true;
+         text.remove_prefix( 1 );
+      }
+      size_t hourDigits = 0;
+      while ( hourDigits < text.size() && text[ hourDigits ] >= '0' && text[ hourDigits ] <= '9' ) {
+         ++hourDigits;
+      }
+      if ( hourDigits < 1 || hourDigits > 3 || !parseDigits( text, hourDigits, time.hour ) ||
+           time.hour > 838 ) {
+         return false;
+      }
+   }
+   return parseSeparator( text, ':' ) && parseDigits( text, 2, time.minute ) &&
+          parseSeparator( text, ':' ) && parseDigits( text, 2, time.second ) &&
+          time.minute < 60 && time.second < 60 && parseFraction( text, time.second_part ) &&
+          text.empty();
+}
+
+namespace detail {
+
+// Integers keep their bit pattern whatever the signedness of the bind, as in the binary protocol
+template <typename Signed>
+bool parseInteger( std::string_view text, void* buffer ) {
+   using Unsigned = std::make_unsigned_t<Signed>;
+   if ( !text.empty() && text.front() == '-' ) {
+      Signed value;
+      if ( !parseNumber( text, value ) ) {
+         return false;
+      }
+      std::memcpy( buffer, &value, sizeof( value ) );
+   } else {
+      Unsigned value;
+      if ( !parseNumber( text, value ) ) {
+         return false;
+      }
+      std::memcpy( buffer, &value, sizeof( value ) );
+   }
+   return true;
+}
+
+}  // namespace detail
+
+// Writes the text value (nullptr for SQL NULL) into bind's buffer, length, is_null and error. A
+// char[] value longer than buffer_length is truncated with error set and length holding its full
+// length. Returns false, with error set, when text is not a valid value of the bind's type.
+inline bool textToBind( MYSQL_BIND& bind, const char* text, unsigned long length ) {
+   bool isNull = text == nullptr;
+   if ( bind.is_null ) {
+      *bind.is_null = isNull;
+   }
+   if ( bind.error ) {
+      *bind.error = false;
+   }
+   if ( isNull ) {
+      return true;
+   }
+
+   std::string_view value( text, length );
+   bool parsed = true;
+   switch ( bind.buffer_type ) {
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_BOOL:
+         parsed = detail::parseInteger<signed char>( value, bind.buffer );
+         break;
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_YEAR:
+         parsed = detail::parseInteger<short>( value, bind.buffer );
+         break;
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_INT24:
+         parsed = detail::parseInteger<int>( value, bind.buffer );
+         break;
+      case MYSQL_TYPE_LONGLONG:
+         parsed = detail::parseInteger<long long>( value, bind.buffer );
+         break;
+      case MYSQL_TYPE_BIT: {
+         // the text protocol sends BIT(n) as its big endian bytes
+         unsigned long long bits = 0;
+         parsed = value.size() <= sizeof( bits );
+         for ( unsigned char byte : value ) {
+            bits = ( bits << 8 ) | byte;
+         }
+         std::memcpy( bind.buffer, &bits, sizeof( bits ) );
+         break;
+      }
+      case MYSQL_TYPE_FLOAT:
+         parsed = parseNumber( value, *static_cast<float*>( bind.buffer ) );
+         break;
+      case MYSQL_TYPE_DOUBLE:
+         parsed = parseNumber( value, *static_cast<double*>( bind.buffer ) );
+         break;
+      case MYSQL_TYPE_DATE:
+      case MYSQL_TYPE_TIME:
+      case MYSQL_TYPE_DATETIME:
+      case MYSQL_TYPE_TIMESTAMP:
+         parsed = parseTime( value, *static_cast<MYSQL_TIME*>( bind.buffer ) );
+         break;
+      default: {
+         size_t copied = std::min<size_t>( length, bind.buffer_length );
+         std::memcpy( bind.buffer, text, copied );
+         if ( bind.length ) {
+            *bind.length = length;
+         }
+         if ( bind.error ) {
+            *bind.error = copied < length;
+         }
+         return true;
+      }
+   }
+
+   if ( bind.length ) {
+      *bind.length = fixedBufferSize( bind.buffer_type );
+   }
+   if ( !parsed && bind.error ) {
+      *bind.error = true;
+   }
+   return parsed;
+}
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_TEXTPARSE_H
@@ -0,0 +1,77 @@
+#ifndef INCLUDED_STATEMENT_H
+#define INCLUDED_STATEMENT_H
+
+#include <mysql/mysql.h>
+
+#include <string>
+#include <string_view>
+
+#include "BindsArray.hpp"
+#include "SqlTypes/SqlTypes.h"
+
+/*
+    A Statement owns one prepared MYSQL_STMT and the pair of BindsArrays its parameters and
+   results are bound from. bindParams()/bindResults() only remember the BindsArrays, the actual
+   mysql_stmt_bind_param()/mysql_stmt_bind_result() calls are made by execute() and only when the
+   BindsArray is a different one or its getBindsVersion() moved since the last time, so executing
+   the same statement over and over with new values costs no rebinding. Versions are unique in the
+   process, so a BindsArray rebuilt where a bound one was destroyed is still bound again, and the
+   number of binds selected is checked against the statement again each time it is bound.
+
+    Assigning values to the columns does not change the binds. borrow()/release() on an InputCType
+   column move its buffer, and with it the BindsArray's getBindsVersion(), so the next execute()
+   binds again.
+
+    Statements are usually obtained from a StatementCache rather than constructed directly.
+*/
+
+namespace set_mysql_binds {
+
+class Statement {
+  private:
+   MYSQL_STMT* stmt;
+   std::string sql;
+
+   BindsArray<InputCType>* params;
+   BindsArray<OutputCType>* results;
+   // BindsArray and version the statement was last bound with
+   const void* boundParams;
+   unsigned long long boundParamsVersion;
+   const void* boundResults;
+   unsigned long long boundResultsVersion;
+
+   void bindIfChanged();
+
+  public:
+   Statement() = delete;
+   // Prepares sql on conn, throws std::runtime_error with the server's message if it fails
+   Statement( MYSQL* conn, std::string_view _sql );
+   Statement( const Statement& ) = delete;
+   Statement& operator=( const Statement& ) = delete;
+   ~Statement();
+
+   void bindParams( BindsArray<InputCType>& _params );
+   void bindResults( BindsArray<OutputCType>& _results );
+   // Forces the next execute() to bind both arrays again
+   void rebind();
+
+   // Binds what changed and executes, throws std::runtime_error on failure
+   void execute();
+   // Fetches the next row into the result binds, false when there are no more rows. Truncated
+   // char[] columns are grown and fetched again through BindsArray::refetchTruncated().
+   bool fetch();
+   // Buffers the whole result set client side, as mysql_stmt_store_result()
+   void storeResult();
+   void freeResult();
+
+   unsigned long paramCount() const { return mysql_stmt_param_count( stmt ); }
+   unsigned int fieldCount() const { return mysql_stmt_field_count( stmt ); }
+   unsigned long long affectedRows() const { return mysql_stmt_affected_rows( stmt ); }
+   unsigned long long insertId() const { return mysql_stmt_insert_id( stmt ); }
+   const std::string& text() const { return sql; }
+   MYSQL_STMT* handle() { return stmt; }
+};
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_STATEMENT_H
@@ -0,0 +1,63 @@
+#ifndef INCLUDED_STATEMENTCACHE_H
+#define INCLUDED_STATEMENTCACHE_H
+
+#include <mysql/mysql.h>
+
+#include <list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Statement.h"
+
+/*
+    A StatementCache keeps the prepared Statements of one connection keyed by their SQL text, so a
+   query prepared once is never sent to the server for parsing again while it stays in the cache.
+   The cache holds at most capacity statements and closes the least recently used one to make
+   room for a new one.
+
+    A Statement reference returned by get() stays valid until that statement is evicted, that is
+   until capacity other statements have been asked for, or the cache is cleared or destroyed. Like
+   the connection it belongs to, a StatementCache is not safe to share between threads.
+*/
+
+namespace set_mysql_binds {
+
+class StatementCache {
+  private:
+   MYSQL* conn;
+   size_t capacity;
+   std::list<Statement> statements;  // most recently used first
+   // keys are views into the Statement's own text
+   std::unordered_map<std::string_view, std::list<Statement>::iterator> index;
+   unsigned long long hitCount;
+   unsigned long long missCount;
+   unsigned long long evictionCount;
+
+  public:
+   StatementCache() = delete;
+   explicit StatementCache( MYSQL* _conn, size_t _capacity = 64 );
+   StatementCache( const StatementCache& ) = delete;
+   StatementCache& operator=( const StatementCache& ) = delete;
+
+   // The cached statement for sql, prepared on a miss. Throws std::runtime_error if sql does not
+   // prepare, in which case nothing is cached.
+   Statement& get( std::string_view sql );
+   // Prepares every statement of sqls ahead of use, typically at startup. Statements that are
+   // already cached are only moved to the front, and none of it counts as hits or misses.
+   void warmUp( std::span<const std::string_view> sqls );
+   void clear();
+
+   bool contains( std::string_view sql ) const { return index.contains( sql ); }
+   size_t size() const { return statements.size(); }
+   size_t getCapacity() const { return capacity; }
+   unsigned long long hits() const { return hitCount; }
+   unsigned long long misses() const { return missCount; }
+   unsigned long long evictions() const { return evictionCount; }
+   MYSQL* connection() { return conn; }
+};
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_STATEMENTCACHE_H
@@ -0,0 +1,186 @@
+#ifndef INCLUDED_STATICBINDSARRAY_H
+#define INCLUDED_STATICBINDSARRAY_H
+
+#include <mysql/mysql.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "makeBinds.hpp"
+
+/*
+    StaticBindsArray is the compile-time counterpart of BindsArray for when every column is known
+   when writing the code, as it is in the makeInputBindsArray()/makeOutputBindsArray() calls.
+   Columns are described with StaticBind<MysqlInputType, "name", buffer size> and stored by value
+   in a std::tuple, so there is no virtual dispatch, no heap allocation per column and no hash map:
+
+      StaticBindsArray<InputCType, StaticBind<INT, "id">, StaticBind<VARCHAR, "name", 64>> row;
+      row.set<"id">( 42 );
+      row.set<"name">( "forty two" );
+      mysql_stmt_bind_param( stmt, row.getBinds() );
+
+    Columns are found by name or index at compile time, a misspelled name does not compile. The
+   C type of each column and its MYSQL_BIND buffer type are the ones BindType<> gives the dynamic
+   InImpl/OutImpl columns for the same direction. All columns are always bound, in declaration
+   order. The MYSQL_BIND array points into the object itself, so it can be neither copied nor moved.
+*/
+
+namespace set_mysql_binds {
+
+template <size_t N>
+struct FixedString {
+   char data[ N ]{};
+   constexpr FixedString( const char ( &str )[ N ] ) { std::copy_n( str, N, data ); }
+   constexpr std::string_view view() const { return { data, N - 1 }; }
+};
+
+template <MysqlInputType Type, FixedString Name, unsigned long BufferSize = 0>
+struct StaticBind {
+   static constexpr MysqlInputType type = Type;
+   static constexpr std::string_view name = Name.view();
+   static constexpr unsigned long bufferSize = BufferSize;
+};
+
+// One column of a StaticBindsArray, Impl is the InImpl/OutImpl the dynamic path would use
+template <typename Impl, unsigned long BufferSize>
+class StaticColumn {
+  public:
+   using value_type = typename Impl::value_type;
+   static constexpr enum_field_types bufferType = Impl::buffer_type;
+   static constexpr bool isCharArray = std::same_as<value_type, std::basic_string<unsigned char>>;
+   static_assert( !isCharArray || BufferSize > 0, "char[] columns need a buffer size" );
+
+   using storage_type =
+       std::conditional_t<isCharArray, std::array<unsigned char, BufferSize>, value_type>;
+
+   storage_type value{};
+   unsigned long length = 0;
+   bool isNull = false;
+   bool error = false;
+
+   void setBind( MYSQL_BIND& bind ) {
+      std::memset( &bind, 0, sizeof( bind ) );
+      bind.buffer_type = bufferType;
+      bind.is_null = &isNull;
+      bind.length = &length;
+      bind.error = &error;
+      if constexpr ( isCharArray ) {
+         bind.buffer = value.data();
+         bind.buffer_length = BufferSize;
+      } else {
+         bind.buffer = &value;
+         bind.is_unsigned = std::is_unsigned_v<value_type>;
+      }
+   }
+
+   void set( const value_type& newValue ) requires( !isCharArray ) {
+      value = newValue;
+      isNull = false;
+   }
+   void set( std::span<const unsigned char> newValue ) requires isCharArray {
+      if ( newValue.size() > BufferSize ) {
+         throw std::out_of_range( "value given to StaticColumn::set() larger than its buffer\n" );
+      }
+      std::copy( newValue.begin(), newValue.end(), value.begin() );
+      length = newValue.size();
+      isNull = false;
+   }
+   void set( std::string_view newValue ) requires isCharArray {
+      set( std::span<const unsigned char>(
+          reinterpret_cast<const unsigned char*>( newValue.data() ), newValue.size() ) );
+   }
+   void setNull() { isNull = true; }
+
+   const value_type& get() const requires( !isCharArray ) { return value; }
+   // After a truncated fetch length is the full server length, the view stops at the buffer
+   std::string_view get() const requires isCharArray {
+      return { reinterpret_cast<const char*>( value.data() ),
+               std::min<size_t>( length, BufferSize ) };
+   }
+};
+
+template <typename Direction, typename... Binds>
+class StaticBindsArray {
+   static_assert( std::same_as<Direction, InputCType> || std::same_as<Direction, OutputCType>,
+                  "StaticBindsArray direction must be InputCType or OutputCType" );
+
+   template <typename B>
+   using ImplOf = std::conditional_t<std::same_as<Direction, InputCType>,
+                                     typename BindType<B::type>::inType,
+                                     typename BindType<B::type>::outType>;
+
+   static constexpr std::array<std::string_view, sizeof...( Binds )> names{ Binds::name... };
+
+   std::tuple<StaticColumn<ImplOf<Binds>, Binds::bufferSize>...> columns;
+   std::array<MYSQL_BIND, sizeof...( Binds )> binds;
+
+   template <size_t... Is>
+   void setBinds( std::index_sequence<Is...> ) {
+      ( std::get<Is>( columns ).setBind( binds[ Is ] ), ... );
+   }
+
+  public:
+   template <FixedString Name>
+   static consteval size_t indexOf() {
+      auto it = std::find( names.begin(), names.end(), Name.view() );
+      if ( it == names.end() ) {
+         throw "field name not found in StaticBindsArray";  // not a constant expression
+      }
+      return static_cast<size_t>( it - names.begin() );
+   }
+
+   StaticBindsArray() { setBinds( std::index_sequence_for<Binds...>{} ); }
+   StaticBindsArray( const StaticBindsArray& ) = delete;
+   StaticBindsArray& operator=( const StaticBindsArray& ) = delete;
+
+   MYSQL_BIND* getBinds() { return binds.data(); }
+   static constexpr size_t getBindsSize() { return sizeof...( Binds ); }
+   static constexpr std::string_view fieldName( size_t index ) { return names[ index ]; }
+
+   template <size_t I>
+   auto& column() {
+      return std::get<I>( columns );
+   }
+   template <FixedString Name>
+   auto& column() {
+      return std::get<indexOf<Name>()>( columns );
+   }
+
+   template <size_t I, typename V>
+   void set( V&& newValue ) {
+      column<I>().set( std::forward<V>( newValue ) );
+   }
+   template <FixedString Name, typename V>
+   void set( V&& newValue ) {
+      column<Name>().set( std::forward<V>( newValue ) );
+   }
+
+   template <size_t I>
+   decltype( auto ) get() const {
+      return std::get<I>( columns ).get();
+   }
+   template <FixedString Name>
+   decltype( auto ) get() const {
+      return std::get<indexOf<Name>()>( columns ).get();
+   }
+
+   template <size_t I>
+   bool isNull() const {
+      return std::get<I>( columns ).isNull;
+   }
+   template <FixedString Name>
+   bool isNull() const {
+      return std::get<indexOf<Name>()>( columns ).isNull;
+   }
+};
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_STATICBINDSARRAY_H
@@ -0,0 +1,117 @@
+#ifndef INCLUDED_TASK_H
+#define INCLUDED_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+/*
+    Task<T> is the coroutine type of the asynchronous API (AsyncConnection, EventLoop). A Task
+   does not start until it is co_await'ed, or handed to EventLoop::spawn(), and resumes whoever
+   awaited it when it finishes, giving back its co_return value or rethrowing its exception.
+*/
+
+namespace set_mysql_binds {
+
+template <typename T>
+class Task;
+
+class TaskPromiseBase {
+   std::exception_ptr exception;
+
+  public:
+   std::coroutine_handle<> continuation;
+
+   struct FinalAwaiter {
+      bool await_ready() const noexcept { return false; }
+      template <typename Promise>
+      std::coroutine_handle<> await_suspend( std::coroutine_handle<Promise> handle ) noexcept {
+         auto next = handle.promise().continuation;
+         return next ? next : std::noop_coroutine();
+      }
+      void await_resume() const noexcept {}
+   };
+
+   std::suspend_always initial_suspend() const noexcept { return {}; }
+   FinalAwaiter final_suspend() const noexcept { return {}; }
+   void unhandled_exception() { exception = std::current_exception(); }
+   void rethrowIfFailed() const {
+      if ( exception ) {
+         std::rethrow_exception( exception );
+      }
+   }
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+   std::optional<T> value;
+
+  public:
+   Task<T> get_return_object();
+   template <typename U>
+   void return_value( U&& _value ) {
+      value.emplace( std::forward<U>( _value ) );
+   }
+   T result() {
+      rethrowIfFailed();
+      return std::move( *value );
+   }
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+  public:
+   Task<void> get_return_object();
+   void return_void() const noexcept {}
+   void result() const { rethrowIfFailed(); }
+};
+
+template <typename T = void>
+class Task {
+  public:
+   using promise_type = TaskPromise<T>;
+
+  private:
+   std::coroutine_handle<promise_type> handle;
+
+  public:
+   explicit Task( std::coroutine_handle<promise_type> _handle ) : handle( _handle ) {}
+   Task( const Task& ) = delete;
+   Task& operator=( const Task& ) = delete;
+   Task( Task&& other ) noexcept : handle( std::exchange( other.handle, nullptr ) ) {}
+   Task& operator=( Task&& other ) noexcept {
+      if ( this != &other ) {
+         if ( handle ) {
+            handle.destroy();
+         }
+         handle = std::exchange( other.handle, nullptr );
+      }
+      return *this;
+   }
+   ~Task() {
+      if ( handle ) {
+         handle.destroy();
+      }
+   }
+
+   bool await_ready() const noexcept { return !handle || handle.done(); }
+   std::coroutine_handle<> await_suspend( std::coroutine_handle<> awaiting ) noexcept {
+      handle.promise().continuation = awaiting;
+      return handle;
+   }
+   T await_resume() { return handle.promise().result(); }
+};
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+   return Task<T>( std::coroutine_handle<TaskPromise<T>>::from_promise( *this ) );
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+   return Task<void>( std::coroutine_handle<TaskPromise<void>>::from_promise( *this ) );
+}
+
+}  // namespace set_mysql_binds
+
+#endif  // INCLUDED_TASK_H
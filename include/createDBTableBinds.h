@@ -10,8 +10,19 @@ namespace set_mysql_binds {
     void createDBTableBinds( const std::string& host, const std::string& user, const std::string& password,
                              const std::string& database, const std::string& declFile, const std::string& defnFile,
                              const std::string& includeStr,
-                             unsigned long buff_size );  // buff_size will be the buff size for all the
-                                                         // binds created that are char[]
+                             unsigned long buff_size );  // buff_size caps the buffers of the binds
+                                                         // created that are char[], each is sized
+                                                         // from its column definition up to it
+
+    // Writes one header/source pair per table into outputDir on threads workers (0 for one per
+    // core) along with an all tables header, <database>AllBinds.h, and a CMake manifest, only
+    // rewriting files whose content changed. Returns the number of files written. Throws
+    // std::runtime_error when two tables, or a table and the all tables header, would share a
+    // file name or include guard, which ignore case.
+    size_t createDBTableBindsPerTable( const std::string& host, const std::string& user,
+                                       const std::string& password, const std::string& database,
+                                       const std::string& outputDir, unsigned long buff_size,
+                                       unsigned int threads = 0 );
 
 }  // namespace set_mysql_binds
 
@@ -13,6 +13,9 @@ struct Field {
    enum_field_types type;
    unsigned long int flags;
    std::string externalType;
+   unsigned long long maxLength = 0;  // CHARACTER_OCTET_LENGTH, 0 when not a character column
+   unsigned int numericPrecision = 0;
+   unsigned int numericScale = 0;
 };
 
 struct Table {
@@ -20,6 +23,8 @@ struct Table {
    std::vector<Field> fields;
 };
 
+// Introspects the connection's current database, throws std::runtime_error on failure
+std::vector<Table> getDBTables( MYSQL* db_conn );
 std::vector<Table> getDBTables( const std::string& host, const std::string& user,
                                 const std::string& password, const std::string& database );
 void printDBTables( std::span<const Table> tables );
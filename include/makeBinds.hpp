@@ -1,8 +1,14 @@
 #ifndef INCLUDED_MAKEBINDS_H
 #define INCLUDED_MAKEBINDS_H
 
+#include <array>
+#include <concepts>
 #include <memory>
+#include <memory_resource>
+#include <new>
 
+#include "BindsArray.hpp"
+#include "ColumnArena.hpp"
 #include "SqlTypes/SqlTypes.h"
 
 namespace set_mysql_binds {
@@ -195,6 +201,30 @@ struct Bind {
    std::unique_ptr<OutputCType> makeOutput() {
       return std::make_unique<outType>( name, buffer_size );
    }
+
+   // Arena construction: Impl is inType or outType, storage comes from allocateIn()
+   template <typename Impl>
+   static constexpr bool hasCharBuffer =
+       std::same_as<typename Impl::value_type, std::basic_string<unsigned char>>;
+
+   template <typename Impl>
+   size_t arenaBytes() const {
+      return sizeof( Impl ) + alignof( Impl ) + ( hasCharBuffer<Impl> ? buffer_size : 0 );
+   }
+
+   template <typename Impl>
+   static void* allocateIn( ColumnArena& arena ) {
+      return arena.allocate( sizeof( Impl ), alignof( Impl ) );
+   }
+
+   template <typename Impl>
+   Impl* constructIn( ColumnArena& arena, void* storage ) {
+      unsigned char* charBuffer = nullptr;
+      if constexpr ( hasCharBuffer<Impl> ) {
+         charBuffer = static_cast<unsigned char*>( arena.allocate( buffer_size, 1 ) );
+      }
+      return ::new ( storage ) Impl( name, buffer_size, charBuffer );
+   }
 };
 
 template <MysqlInputType... Ts>
@@ -213,6 +243,44 @@ BindsArray<OutputCType> makeOutputBindsArray( Bind<Ts>... objects ) {
    return BindsArray<OutputCType>( std::move( vec ) );
 }
 
+// Arena construction mode: every column object is placed first so they sit next to each other,
+// then the char[] value buffers, then the BindsArray's own MYSQL_BIND array and lookup containers.
+template <typename T, typename... Impls, MysqlInputType... Ts>
+BindsArray<T> makeArenaBindsArray( std::pmr::memory_resource* upstream, Bind<Ts>... objects ) {
+   auto arena = std::make_unique<ColumnArena>(
+       ( 0 + ... + objects.template arenaBytes<Impls>() ) +
+           BindsArray<T>::arenaOverhead( sizeof...( objects ) ),
+       upstream );
+   std::array<void*, sizeof...( objects )> storage{ Bind<Ts>::template allocateIn<Impls>(
+       *arena )... };
+   std::array<T*, sizeof...( objects )> columns;
+   size_t i = 0;
+   ( ( columns[ i ] = objects.template constructIn<Impls>( *arena, storage[ i ] ), ++i ), ... );
+   return BindsArray<T>( std::move( arena ), std::span<T* const>( columns ) );
+}
+
+template <MysqlInputType... Ts>
+BindsArray<InputCType> makeArenaInputBindsArray( std::pmr::memory_resource* upstream,
+                                                 Bind<Ts>... objects ) {
+   return makeArenaBindsArray<InputCType, typename Bind<Ts>::inType...>( upstream, objects... );
+}
+
+template <MysqlInputType... Ts>
+BindsArray<InputCType> makeArenaInputBindsArray( Bind<Ts>... objects ) {
+   return makeArenaInputBindsArray( std::pmr::get_default_resource(), objects... );
+}
+
+template <MysqlInputType... Ts>
+BindsArray<OutputCType> makeArenaOutputBindsArray( std::pmr::memory_resource* upstream,
+                                                   Bind<Ts>... objects ) {
+   return makeArenaBindsArray<OutputCType, typename Bind<Ts>::outType...>( upstream, objects... );
+}
+
+template <MysqlInputType... Ts>
+BindsArray<OutputCType> makeArenaOutputBindsArray( Bind<Ts>... objects ) {
+   return makeArenaOutputBindsArray( std::pmr::get_default_resource(), objects... );
+}
+
 }  // namespace set_mysql_binds
 
 #endif  // INCLUDED_MAKEBINDS_H
\ No newline at end of file
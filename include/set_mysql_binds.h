@@ -1,10 +1,26 @@
 #ifndef INCLUDED_SET_MYSQL_BINDS_H
 #define INCLUDED_SET_MYSQL_BINDS_H
 
+#include "ArrowExport.h"
+#include "AsyncConnection.h"
+#include "BatchInsert.h"
 #include "BindsArray.hpp"
+#include "BulkLoader.h"
+#include "ColumnarBatch.h"
+#include "ConnectionPool.h"
+#include "Decimal.h"
+#include "EventLoop.h"
 #include "createDBTableBinds.h"
 #include "getDBTables.h"
 #include "makeBinds.hpp"
+#include "MysqlTime.h"
+#include "RowBinds.hpp"
+#include "RowCursor.h"
+#include "RowWriter.h"
+#include "SchemaSnapshot.h"
+#include "Statement.h"
+#include "StatementCache.h"
+#include "StaticBindsArray.hpp"
 
 #include "utilities.h"
 
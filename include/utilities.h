@@ -11,10 +11,15 @@ namespace set_mysql_binds {
 
 extern const std::array<std::string_view, 256> fieldTypes;
 
+// Checked by InputCType::operator=( long double ) on every write, the typed InputCType::set()
+// writes take a checking policy instead
 extern bool strict_fundamental_type_checking;
 
 bool isCharArray( enum_field_types type );
 
+// Size in bytes of the C value behind a fixed width buffer type, 0 for char[] buffer types
+unsigned long fixedBufferSize( enum_field_types type );
+
 }  // namespace set_mysql_binds
 
 #endif  // INCLUDED_UTILITIES_H
\ No newline at end of file
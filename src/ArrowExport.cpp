@@ -0,0 +1,205 @@
+#include "ArrowExport.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "MysqlTime.h"
+
+namespace set_mysql_binds {
+
+const char* arrowFormat( const ColumnarColumn& column, const ArrowExportOptions& options ) {
+   switch ( column.bufferType ) {
+      case MYSQL_TYPE_TINY:
+         return column.isUnsigned ? "C" : "c";
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_YEAR:
+         return column.isUnsigned ? "S" : "s";
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_INT24:
+         return column.isUnsigned ? "I" : "i";
+      case MYSQL_TYPE_LONGLONG:
+         return column.isUnsigned ? "L" : "l";
+      case MYSQL_TYPE_BIT:
+         return "L";
+      case MYSQL_TYPE_FLOAT:
+         return "f";
+      case MYSQL_TYPE_DOUBLE:
+         return "g";
+      case MYSQL_TYPE_DATE:
+         return "tdD";
+      case MYSQL_TYPE_DATETIME:
+      case MYSQL_TYPE_TIMESTAMP:
+         return "tsu:";
+      case MYSQL_TYPE_TIME:
+         return "tDu";
+      case MYSQL_TYPE_STRING:
+      case MYSQL_TYPE_VAR_STRING:
+      case MYSQL_TYPE_VARCHAR:
+      case MYSQL_TYPE_NEWDECIMAL:
+      case MYSQL_TYPE_DECIMAL:
+      case MYSQL_TYPE_ENUM:
+      case MYSQL_TYPE_SET:
+      case MYSQL_TYPE_JSON:
+         return "u";
+      case MYSQL_TYPE_TINY_BLOB:
+      case MYSQL_TYPE_BLOB:
+      case MYSQL_TYPE_MEDIUM_BLOB:
+      case MYSQL_TYPE_LONG_BLOB:
+      case MYSQL_TYPE_GEOMETRY:
+         return options.blobsAsUtf8 ? "u" : "z";
+      default:
+         throw std::runtime_error( "No Arrow type for column \"" + column.name + "\" of type " +
+                                   std::string( fieldTypes[ column.bufferType ] ) + '\n' );
+   }
+}
+
+namespace {
+
+// Owns everything one exported child array points to
+struct ColumnHolder {
+   ColumnarColumn column;
+   std::vector<std::int64_t> temporal;  // converted values of DATE/DATETIME/TIME columns
+   std::vector<std::int32_t> days;      // those of a DATE column narrowed to date32
+   const void* buffers[ 3 ];
+};
+
+struct ParentHolder {
+   std::vector<ArrowArray> children;
+   std::vector<ArrowArray*> childPointers;
+   const void* buffers[ 1 ] = { nullptr };
+};
+
+struct SchemaHolder {
+   std::vector<ArrowSchema> children;
+   std::vector<ArrowSchema*> childPointers;
+};
+
+void releaseChildArray( ArrowArray* array ) {
+   delete static_cast<ColumnHolder*>( array->private_data );
+   array->release = nullptr;
+}
+
+void releaseParentArray( ArrowArray* array ) {
+   auto* holder = static_cast<ParentHolder*>( array->private_data );
+   // children the consumer moved out have their release set to nullptr
+   for ( auto& child : holder->children ) {
+      if ( child.release ) {
+         child.release( &child );
+      }
+   }
+   delete holder;
+   array->release = nullptr;
+}
+
+// A column's schema owns its name
+void releaseChildSchema( ArrowSchema* schema ) {
+   delete static_cast<std::string*>( schema->private_data );
+   schema->release = nullptr;
+}
+
+void releaseSchema( ArrowSchema* schema ) {
+   auto* holder = static_cast<SchemaHolder*>( schema->private_data );
+   for ( auto& child : holder->children ) {
+      if ( child.release ) {
+         child.release( &child );
+      }
+   }
+   delete holder;
+   schema->release = nullptr;
+}
+
+// The values of a temporal column counted from the epoch as Arrow wants them, returns the buffer
+// holding them
+const void* convertTemporal( ColumnHolder& holder, size_t rows ) {
+   holder.temporal.resize( rows );
+   toEpochValues( holder.column, rows, holder.temporal );
+   holder.column.fixedValues = {};
+   if ( holder.column.bufferType != MYSQL_TYPE_DATE ) {
+      return holder.temporal.data();
+   }
+   // date32 is 32 bits wide
+   holder.days.resize( rows );
+   std::transform( holder.temporal.begin(), holder.temporal.end(), holder.days.begin(),
+                   []( std::int64_t days ) { return static_cast<std::int32_t>( days ); } );
+   holder.temporal = {};
+   return holder.days.data();
+}
+
+}  // namespace
+
+void exportArrow( ColumnarBatch& batch, ArrowSchema* schema, ArrowArray* array,
+                  const ArrowExportOptions& options ) {
+   const size_t rows = batch.size();
+   const size_t columnCount = batch.columnCount();
+   std::vector<const char*> formats;
+   for ( size_t c = 0; c < columnCount; ++c ) {
+      formats.push_back( arrowFormat( batch.column( c ), options ) );
+   }
+
+   auto schemaHolder = std::make_unique<SchemaHolder>();
+   schemaHolder->children.resize( columnCount );
+   auto parentHolder = std::make_unique<ParentHolder>();
+   parentHolder->children.resize( columnCount );
+
+   std::vector<ColumnarColumn> columns = batch.takeColumns();
+   for ( size_t c = 0; c < columnCount; ++c ) {
+      auto holder = std::make_unique<ColumnHolder>();
+      holder->column = std::move( columns[ c ] );
+      const ColumnarColumn& column = holder->column;
+
+      ArrowSchema& childSchema = schemaHolder->children[ c ];
+      childSchema = ArrowSchema{};
+      childSchema.format = formats[ c ];
+      childSchema.flags = ARROW_FLAG_NULLABLE;
+      auto* name = new std::string( column.name );
+      childSchema.name = name->c_str();
+      childSchema.private_data = name;
+      childSchema.release = releaseChildSchema;
+
+      ArrowArray& child = parentHolder->children[ c ];
+      child = ArrowArray{};
+      child.length = static_cast<int64_t>( rows );
+      child.null_count = static_cast<int64_t>( column.nullCount );
+      child.buffers = holder->buffers;
+      holder->buffers[ 0 ] = column.validity.data();
+      if ( !column.isFixedWidth() ) {
+         child.n_buffers = 3;
+         holder->buffers[ 1 ] = column.offsets.data();
+         holder->buffers[ 2 ] = column.data.data();
+      } else if ( column.width == sizeof( MYSQL_TIME ) ) {
+         child.n_buffers = 2;
+         holder->buffers[ 1 ] = convertTemporal( *holder, rows );
+      } else {
+         child.n_buffers = 2;
+         holder->buffers[ 1 ] = column.fixedValues.data();
+      }
+      child.release = releaseChildArray;
+      child.private_data = holder.release();
+      parentHolder->childPointers.push_back( &child );
+   }
+   for ( size_t c = 0; c < columnCount; ++c ) {
+      schemaHolder->childPointers.push_back( &schemaHolder->children[ c ] );
+   }
+
+   *schema = ArrowSchema{};
+   schema->format = "+s";
+   schema->name = "";
+   schema->n_children = static_cast<int64_t>( columnCount );
+   schema->children = schemaHolder->childPointers.data();
+   schema->release = releaseSchema;
+   schema->private_data = schemaHolder.release();
+
+   *array = ArrowArray{};
+   array->length = static_cast<int64_t>( rows );
+   array->n_buffers = 1;
+   array->n_children = static_cast<int64_t>( columnCount );
+   array->buffers = parentHolder->buffers;
+   array->children = parentHolder->childPointers.data();
+   array->release = releaseParentArray;
+   array->private_data = parentHolder.release();
+}
+
+}  // namespace set_mysql_binds
@@ -0,0 +1,140 @@
+#include "AsyncConnection.h"
+
+#include <linux/sockios.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "SqlTypes/TextParse.hpp"
+
+namespace set_mysql_binds {
+
+AsyncConnection::AsyncConnection( EventLoop& _loop ) : loop( _loop ), result( nullptr ) {
+   initClientLibrary();
+   mysql = mysql_init( nullptr );
+   if ( mysql == nullptr ) {
+      throw std::runtime_error( "mysql_init() could not allocate a connection handle\n" );
+   }
+}
+
+AsyncConnection::~AsyncConnection() {
+   if ( result ) {
+      mysql_free_result( result );
+   }
+   mysql_close( mysql );
+}
+
+void AsyncConnection::throwError() { throw std::runtime_error( mysql_error( mysql ) ); }
+
+// The library does not say whether it is blocked reading or writing. It only writes whole
+// packets, so while the socket's send queue holds unsent bytes it may be waiting for room,
+// otherwise it is waiting for the server.
+EventLoop::SocketReady AsyncConnection::socketReady() {
+   int fd = mysql->net.fd;
+   int unsent = 0;
+   std::uint32_t events = EPOLLIN;
+   if ( fd >= 0 && ioctl( fd, SIOCOUTQ, &unsent ) == 0 && unsent > 0 ) {
+      events |= EPOLLOUT;
+   }
+   return loop.waitFor( fd, events );
+}
+
+Task<void> AsyncConnection::connect( const ConnectionOptions& options ) {
+   net_async_status status;
+   while ( ( status = mysql_real_connect_nonblocking(
+                 mysql, options.host.c_str(), options.user.c_str(), options.password.c_str(),
+                 options.database.c_str(), options.port,
+                 options.unixSocket.empty() ? nullptr : options.unixSocket.c_str(), 0 ) ) ==
+           NET_ASYNC_NOT_READY ) {
+      co_await socketReady();
+   }
+   if ( status == NET_ASYNC_ERROR ) {
+      throwError();
+   }
+}
+
+Task<void> AsyncConnection::query( std::string_view sql ) {
+   if ( result ) {
+      throw std::runtime_error( "AsyncConnection::query() before the previous result was freed\n" );
+   }
+   net_async_status status;
+   while ( ( status = mysql_real_query_nonblocking( mysql, sql.data(), sql.size() ) ) ==
+           NET_ASYNC_NOT_READY ) {
+      co_await socketReady();
+   }
+   if ( status == NET_ASYNC_ERROR ) {
+      throwError();
+   }
+   if ( mysql_field_count( mysql ) ) {
+      // only sets the result up, rows are read by mysql_fetch_row_nonblocking()
+      result = mysql_use_result( mysql );
+      if ( result == nullptr ) {
+         throwError();
+      }
+   }
+}
+
+Task<bool> AsyncConnection::fetchRow( BindsArray<OutputCType>& row ) {
+   if ( result == nullptr ) {
+      co_return false;
+   }
+   MYSQL_ROW values = nullptr;
+   net_async_status status;
+   while ( ( status = mysql_fetch_row_nonblocking( result, &values ) ) == NET_ASYNC_NOT_READY ) {
+      co_await socketReady();
+   }
+   if ( status == NET_ASYNC_ERROR ) {
+      throwError();
+   }
+   if ( values == nullptr ) {
+      bool failed = mysql_errno( mysql ) != 0;
+      mysql_free_result( result );  // every row was read, nothing left to block on
+      result = nullptr;
+      if ( failed ) {
+         throwError();
+      }
+      co_return false;
+   }
+
+   // On an error the rest of the result is drained first, so the connection can take the next
+   // query, the throw has to wait for that as co_await is not allowed in a catch handler
+   std::string error;
+   unsigned int fieldCount = mysql_num_fields( result );
+   if ( row.getBindsSize() != fieldCount ) {
+      error = "BindsArray given to fetchRow() has " + std::to_string( row.getBindsSize() ) +
+              " binds selected for a result with " + std::to_string( fieldCount ) + " columns\n";
+   } else {
+      unsigned long* lengths = mysql_fetch_lengths( result );
+      MYSQL_BIND* binds = row.getBinds();
+      for ( unsigned int i = 0; i < fieldCount; ++i ) {
+         if ( !textToBind( binds[ i ], values[ i ], lengths[ i ] ) ) {
+            error = "fetchRow() could not convert '" + std::string( values[ i ], lengths[ i ] ) +
+                    "' of column " + std::to_string( i ) + " to the type of its bind\n";
+            break;
+         }
+      }
+   }
+   if ( !error.empty() ) {
+      co_await freeResult();
+      throw std::runtime_error( error );
+   }
+   co_return true;
+}
+
+Task<void> AsyncConnection::freeResult() {
+   if ( result == nullptr ) {
+      co_return;
+   }
+   net_async_status status;
+   while ( ( status = mysql_free_result_nonblocking( result ) ) == NET_ASYNC_NOT_READY ) {
+      co_await socketReady();
+   }
+   result = nullptr;
+   if ( status == NET_ASYNC_ERROR ) {
+      throwError();
+   }
+}
+
+}  // namespace set_mysql_binds
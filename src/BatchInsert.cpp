@@ -0,0 +1,188 @@
+#include "BatchInsert.h"
+
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include "utilities.h"
+
+namespace set_mysql_binds {
+
+// Prepared statements are limited to 65535 placeholders
+static constexpr size_t maxPlaceholders = 65535;
+
+BatchInsert::BatchInsert( MYSQL* _conn, std::string_view _table, BindsArray<InputCType>& _layout,
+                          size_t _maxRows, size_t _maxBytes )
+    : conn( _conn ),
+      layout( _layout ),
+      table( _table ),
+      columnCount( _layout.getBindsSize() ),
+      maxRows( _maxRows ),
+      maxBytes( _maxBytes ),
+      rowStride( 0 ),
+      rows( 0 ),
+      bytes( 0 ),
+      written( 0 ),
+      fullStmt( nullptr ) {
+   if ( !columnCount || !maxRows ) {
+      throw std::runtime_error( "BatchInsert needs at least one selected column and one row\n" );
+   }
+   if ( columnCount * maxRows > maxPlaceholders ) {
+      std::ostringstream os;
+      os << "BatchInsert of " << maxRows << " rows x " << columnCount
+         << " columns exceeds the prepared statement placeholder limit of " << maxPlaceholders;
+      throw std::runtime_error( std::move( os.str() ) );
+   }
+
+   std::for_each( layout.fields.begin(), layout.fields.end(), [ & ]( const auto* field ) {
+      if ( field->is_selected ) {
+         columnNames.emplace_back( field->fieldName );
+      }
+   } );
+
+   // Every staged row gets the same layout, char[] columns reserve their full buffer length
+   const MYSQL_BIND* source = layout.getBinds();
+   for ( size_t c = 0; c < columnCount; ++c ) {
+      unsigned long capacity = fixedBufferSize( source[ c ].buffer_type );
+      if ( !capacity ) {
+         capacity = source[ c ].buffer_length;
+      }
+      offsets.push_back( rowStride );
+      capacities.push_back( capacity );
+      constexpr size_t align = alignof( std::max_align_t );
+      rowStride += ( capacity + align - 1 ) & ~( align - 1 );
+   }
+
+   data.resize( rowStride * maxRows );
+   lengths.resize( columnCount * maxRows );
+   nulls = std::make_unique<bool[]>( columnCount * maxRows );
+   binds.resize( columnCount * maxRows );
+
+   for ( size_t r = 0; r < maxRows; ++r ) {
+      for ( size_t c = 0; c < columnCount; ++c ) {
+         MYSQL_BIND& bind = binds[ r * columnCount + c ];
+         std::memset( &bind, 0, sizeof( bind ) );
+         bind.buffer_type = source[ c ].buffer_type;
+         bind.buffer = data.data() + r * rowStride + offsets[ c ];
+         bind.buffer_length = capacities[ c ];
+         bind.length = &lengths[ r * columnCount + c ];
+         bind.is_null = &nulls[ r * columnCount + c ];
+         bind.is_unsigned = source[ c ].is_unsigned;
+      }
+   }
+}
+
+BatchInsert::~BatchInsert() {
+   if ( fullStmt ) {
+      mysql_stmt_close( fullStmt );
+   }
+}
+
+std::string BatchInsert::makeInsertQuery( size_t rowCount ) const {
+   std::ostringstream os;
+   os << "INSERT INTO `" << table << "` (";
+   for ( size_t c = 0; c < columnCount; ++c ) {
+      os << ( c ? ", `" : "`" ) << columnNames[ c ] << '`';
+   }
+   os << ") VALUES ";
+
+   std::string row( "(" );
+   for ( size_t c = 0; c < columnCount; ++c ) {
+      row += ( c ? ",?" : "?" );
+   }
+   row += ')';
+   for ( size_t r = 0; r < rowCount; ++r ) {
+      os << ( r ? "," : "" ) << row;
+   }
+   return os.str();
+}
+
+MYSQL_STMT* BatchInsert::prepare( size_t rowCount ) {
+   MYSQL_STMT* stmt = mysql_stmt_init( conn );
+   if ( stmt == nullptr ) {
+      throw std::runtime_error( mysql_error( conn ) );
+   }
+   std::string query = makeInsertQuery( rowCount );
+   if ( mysql_stmt_prepare( stmt, query.c_str(), query.size() ) ) {
+      std::string error = mysql_stmt_error( stmt );
+      mysql_stmt_close( stmt );
+      throw std::runtime_error( error );
+   }
+   return stmt;
+}
+
+void BatchInsert::execute( MYSQL_STMT* stmt, size_t rowCount ) {
+   if ( mysql_stmt_bind_param( stmt, binds.data() ) || mysql_stmt_execute( stmt ) ) {
+      throw std::runtime_error( mysql_stmt_error( stmt ) );
+   }
+   written += rowCount;
+}
+
+void BatchInsert::addRow() {
+   const MYSQL_BIND* source = layout.getBinds();
+   auto valueLength = [ & ]( size_t c ) {
+      return fixedBufferSize( source[ c ].buffer_type ) ? capacities[ c ] : *source[ c ].length;
+   };
+
+   // every length is checked before anything of the row is staged
+   size_t rowBytes = 0;
+   for ( size_t c = 0; c < columnCount; ++c ) {
+      unsigned long length = valueLength( c );
+      if ( length > capacities[ c ] ) {
+         std::ostringstream os;
+         os << "Value of length " << length << " for column \"" << columnNames[ c ]
+            << "\" exceeds its bind buffer of " << capacities[ c ] << '\n';
+         throw std::runtime_error( std::move( os.str() ) );
+      }
+      rowBytes += length;
+   }
+   // a full staging area is left by a flush that threw, it is sent again before the row goes in
+   if ( rows == maxRows || ( rows && bytes + rowBytes > maxBytes ) ) {
+      flush();
+   }
+
+   unsigned char* slot = data.data() + rows * rowStride;
+   for ( size_t c = 0; c < columnCount; ++c ) {
+      size_t index = rows * columnCount + c;
+      nulls[ index ] = *source[ c ].is_null;
+      unsigned long length = valueLength( c );
+      std::memcpy( slot + offsets[ c ], source[ c ].buffer, length );
+      lengths[ index ] = length;
+   }
+
+   bytes += rowBytes;
+   if ( ++rows == maxRows ) {
+      flush();
+   }
+}
+
+size_t BatchInsert::flush() {
+   size_t count = rows;
+   if ( !count ) {
+      return 0;
+   }
+
+   if ( count == maxRows ) {
+      if ( fullStmt == nullptr ) {
+         fullStmt = prepare( maxRows );
+      }
+      execute( fullStmt, count );
+   } else {
+      // A short batch is rare (end of input or byte budget), so its statement is not kept
+      MYSQL_STMT* stmt = prepare( count );
+      try {
+         execute( stmt, count );
+      } catch ( ... ) {
+         mysql_stmt_close( stmt );
+         throw;
+      }
+      mysql_stmt_close( stmt );
+   }
+
+   rows = 0;
+   bytes = 0;
+   return count;
+}
+
+}  // namespace set_mysql_binds
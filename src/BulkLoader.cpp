@@ -0,0 +1,183 @@
+#include "BulkLoader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace set_mysql_binds {
+
+// CR_UNKNOWN_ERROR, what the client reports for a stream the loader aborted
+static constexpr int abortedStreamError = 2000;
+
+// name quoted with backticks, those in it doubled
+static void appendIdentifier( std::string& query, std::string_view name ) {
+   query += '`';
+   for ( char c : name ) {
+      query += c;
+      if ( c == '`' ) {
+         query += '`';
+      }
+   }
+   query += '`';
+}
+
+BulkLoader::BulkLoader( MYSQL* _conn, std::string_view _table, BindsArray<InputCType>& _layout,
+                        size_t _chunkBytes, size_t _maxQueued )
+    : conn( _conn ),
+      layout( _layout ),
+      table( _table ),
+      chunkBytes( std::max<size_t>( _chunkBytes, 1 ) ),
+      maxQueued( std::max<size_t>( _maxQueued, 1 ) ),
+      writer( chunk, RowFormat::Tsv ),
+      added( 0 ),
+      ended( false ),
+      aborted( false ),
+      done( false ),
+      loaded( 0 ),
+      readOffset( 0 ) {
+   if ( !layout.getBindsSize() ) {
+      throw std::runtime_error( "BulkLoader needs at least one selected column\n" );
+   }
+
+   // The file name is only handed to initStream(), no file is opened. The columns are those of
+   // getBinds(), which the rows are written from, selection or projection alike.
+   query = "LOAD DATA LOCAL INFILE 'set_mysql_binds' INTO TABLE ";
+   appendIdentifier( query, table );
+   query += " (";
+   bool first = true;
+   for ( std::string_view name : layout.selectedFieldNames() ) {
+      query += first ? "" : ", ";
+      appendIdentifier( query, name );
+      first = false;
+   }
+   query += ')';
+
+   chunk.reserve( chunkBytes );
+   loader = std::thread( &BulkLoader::load, this );
+}
+
+BulkLoader::~BulkLoader() {
+   if ( loader.joinable() ) {
+      {
+         std::lock_guard lock( mutex );
+         aborted = true;
+      }
+      changed.notify_all();
+      loader.join();
+   }
+}
+
+void BulkLoader::load() {
+   mysql_thread_init();
+   mysql_set_local_infile_handler( conn, initStream, readStream, endStream, streamError, this );
+   bool failed = mysql_real_query( conn, query.c_str(), query.size() ) != 0;
+   {
+      std::lock_guard lock( mutex );
+      if ( failed ) {
+         error = mysql_error( conn );
+      } else {
+         loaded = mysql_affected_rows( conn );
+      }
+      done = true;
+   }
+   changed.notify_all();
+   mysql_set_local_infile_default( conn );
+   mysql_thread_end();
+}
+
+int BulkLoader::initStream( void** stream, const char*, void* loader ) {
+   *stream = loader;
+   return 0;
+}
+
+int BulkLoader::readStream( void* stream, char* buffer, unsigned int size ) {
+   auto& self = *static_cast<BulkLoader*>( stream );
+   while ( self.readOffset == self.reading.size() ) {
+      std::unique_lock lock( self.mutex );
+      if ( self.reading.capacity() ) {
+         self.reading.clear();
+         self.spare.push_back( std::move( self.reading ) );
+         self.reading = std::string();
+      }
+      self.changed.wait(
+          lock, [ & ] { return !self.queued.empty() || self.ended || self.aborted; } );
+      if ( self.aborted ) {
+         return -1;
+      }
+      if ( self.queued.empty() ) {
+         return 0;  // the end of the stream
+      }
+      self.reading = std::move( self.queued.front() );
+      self.queued.pop_front();
+      self.readOffset = 0;
+      lock.unlock();
+      // a queue slot came free
+      self.changed.notify_all();
+   }
+   size_t length = std::min<size_t>( size, self.reading.size() - self.readOffset );
+   std::memcpy( buffer, self.reading.data() + self.readOffset, length );
+   self.readOffset += length;
+   return static_cast<int>( length );
+}
+
+void BulkLoader::endStream( void* ) {}
+
+int BulkLoader::streamError( void*, char* message, unsigned int size ) {
+   std::strncpy( message, "BulkLoader aborted before finish()", size );
+   if ( size ) {
+      message[ size - 1 ] = '\0';
+   }
+   return abortedStreamError;
+}
+
+void BulkLoader::throwLoadError() {
+   throw std::runtime_error( "LOAD DATA into `" + table + "` failed: " + error + '\n' );
+}
+
+// Hands the chunk to the loading thread and takes a sent one to write the next into
+void BulkLoader::queueChunk() {
+   std::unique_lock lock( mutex );
+   changed.wait( lock, [ & ] { return queued.size() < maxQueued || done; } );
+   if ( done ) {
+      // the statement returned before its stream ended, it failed
+      throwLoadError();
+   }
+   queued.push_back( std::move( chunk ) );
+   if ( spare.empty() ) {
+      chunk = std::string();
+      chunk.reserve( chunkBytes );
+   } else {
+      chunk = std::move( spare.back() );
+      spare.pop_back();
+   }
+   lock.unlock();
+   changed.notify_all();
+}
+
+void BulkLoader::addRow() {
+   writer.writeRow( layout );
+   ++added;
+   if ( chunk.size() >= chunkBytes ) {
+      queueChunk();
+   }
+}
+
+unsigned long long BulkLoader::finish() {
+   if ( loader.joinable() ) {
+      if ( !chunk.empty() ) {
+         queueChunk();
+      }
+      {
+         std::lock_guard lock( mutex );
+         ended = true;
+      }
+      changed.notify_all();
+      loader.join();
+   }
+   if ( !error.empty() ) {
+      throwLoadError();
+   }
+   return loaded;
+}
+
+}  // namespace set_mysql_binds
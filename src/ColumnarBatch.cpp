@@ -0,0 +1,124 @@
+#include "ColumnarBatch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "utilities.h"
+
+namespace set_mysql_binds {
+
+ColumnarBatch::ColumnarBatch( BindsArray<OutputCType>& _layout, size_t _capacity )
+    : layout( _layout ), capacity( _capacity ), rows( 0 ) {
+   if ( !capacity ) {
+      throw std::runtime_error( "ColumnarBatch needs room for at least one row\n" );
+   }
+   layoutColumns();
+}
+
+void ColumnarBatch::layoutColumns() {
+   std::vector<std::string_view> names = layout.selectedFieldNames();
+   const MYSQL_BIND* binds = layout.getBinds();
+   columns.resize( names.size() );
+   for ( size_t c = 0; c < columns.size(); ++c ) {
+      ColumnarColumn& column = columns[ c ];
+      column.name = names[ c ];
+      column.bufferType = binds[ c ].buffer_type;
+      column.isUnsigned = binds[ c ].is_unsigned;
+      column.width = fixedBufferSize( binds[ c ].buffer_type );
+      if ( column.isFixedWidth() ) {
+         column.fixedValues.resize( capacity * column.width );
+      } else {
+         column.offsets.reserve( capacity + 1 );
+         column.offsets.push_back( 0 );
+         column.data.reserve( capacity * std::min<size_t>( binds[ c ].buffer_length, 64 ) );
+      }
+      column.validity.resize( ( capacity + 7 ) / 8 );
+   }
+}
+
+// The length a char[] column's value takes in its data, 0 for NULL
+static size_t valueLength( const MYSQL_BIND& bind ) {
+   return *bind.is_null ? 0 : std::min<size_t>( *bind.length, bind.buffer_length );
+}
+
+void ColumnarBatch::appendRow() {
+   if ( rows == capacity ) {
+      throw std::out_of_range( "ColumnarBatch::appendRow() on a full batch\n" );
+   }
+   const MYSQL_BIND* binds = layout.getBinds();
+   // Every column is checked before any is written, so a row too long leaves them all in step
+   for ( size_t c = 0; c < columns.size(); ++c ) {
+      const ColumnarColumn& column = columns[ c ];
+      if ( !column.isFixedWidth() &&
+           column.data.size() + valueLength( binds[ c ] ) >
+               static_cast<size_t>( std::numeric_limits<std::int32_t>::max() ) ) {
+         throw std::length_error( "ColumnarBatch column \"" + column.name +
+                                  "\" over the 2GiB of int32 offsets, use smaller batches\n" );
+      }
+   }
+   for ( size_t c = 0; c < columns.size(); ++c ) {
+      ColumnarColumn& column = columns[ c ];
+      const MYSQL_BIND& bind = binds[ c ];
+      bool isNull = *bind.is_null;
+      if ( isNull ) {
+         ++column.nullCount;
+         column.validity[ rows / 8 ] &= static_cast<std::uint8_t>( ~( 1U << ( rows % 8 ) ) );
+      } else {
+         column.validity[ rows / 8 ] |= static_cast<std::uint8_t>( 1U << ( rows % 8 ) );
+      }
+
+      if ( column.isFixedWidth() ) {
+         unsigned char* slot = column.fixedValues.data() + rows * column.width;
+         if ( isNull ) {
+            std::memset( slot, 0, column.width );
+         } else {
+            std::memcpy( slot, bind.buffer, column.width );
+         }
+      } else {
+         const auto* value = static_cast<const unsigned char*>( bind.buffer );
+         column.data.insert( column.data.end(), value, value + valueLength( bind ) );
+         column.offsets.push_back( static_cast<std::int32_t>( column.data.size() ) );
+      }
+   }
+   ++rows;
+}
+
+size_t ColumnarBatch::fill( Statement& statement ) {
+   size_t added = 0;
+   while ( rows < capacity && statement.fetch() ) {
+      appendRow();
+      ++added;
+   }
+   return added;
+}
+
+void ColumnarBatch::clear() {
+   rows = 0;
+   std::for_each( columns.begin(), columns.end(), [ & ]( auto& column ) {
+      column.nullCount = 0;
+      if ( !column.isFixedWidth() ) {
+         column.offsets.resize( 1 );
+         column.data.clear();
+      }
+   } );
+}
+
+std::vector<ColumnarColumn> ColumnarBatch::takeColumns() {
+   std::vector<ColumnarColumn> taken = std::move( columns );
+   columns.clear();
+   rows = 0;
+   layoutColumns();
+   return taken;
+}
+
+const ColumnarColumn& ColumnarBatch::column( std::string_view name ) const {
+   auto found = std::find_if( columns.begin(), columns.end(),
+                              [ & ]( const auto& column ) { return column.name == name; } );
+   if ( found == columns.end() ) {
+      throw std::runtime_error( "Column \"" + std::string( name ) + "\" not in ColumnarBatch\n" );
+   }
+   return *found;
+}
+
+}  // namespace set_mysql_binds
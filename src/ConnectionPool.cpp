@@ -0,0 +1,210 @@
+#include "ConnectionPool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace set_mysql_binds {
+
+namespace {
+
+// mysql_init() sets up the client library's per-thread state, this tears it down at thread exit
+struct ThreadEnd {
+   ~ThreadEnd() { mysql_thread_end(); }
+};
+
+}  // namespace
+
+void initClientLibrary() {
+   static std::once_flag initialized;
+   // an exception leaves the flag unset, so a later call tries again
+   std::call_once( initialized, [] {
+      if ( mysql_library_init( 0, nullptr, nullptr ) ) {
+         throw std::runtime_error( "could not initialize MySQL client library\n" );
+      }
+      std::atexit( [] { mysql_library_end(); } );
+   } );
+}
+
+MYSQL* openConnection( const ConnectionOptions& options ) {
+   initClientLibrary();
+   thread_local ThreadEnd threadEnd;
+
+   MYSQL* mysql = mysql_init( nullptr );
+   if ( mysql == nullptr ) {
+      throw std::runtime_error( "mysql_init() could not allocate a connection handle\n" );
+   }
+   if ( options.localInfile ) {
+      // the server only asks for local files when the client announced it on connecting
+      unsigned int enable = 1;
+      mysql_options( mysql, MYSQL_OPT_LOCAL_INFILE, &enable );
+   }
+   if ( mysql_real_connect( mysql, options.host.c_str(), options.user.c_str(),
+                            options.password.c_str(), options.database.c_str(), options.port,
+                            options.unixSocket.empty() ? nullptr : options.unixSocket.c_str(),
+                            0 ) == nullptr ) {
+      std::string error = mysql_error( mysql );
+      mysql_close( mysql );
+      throw std::runtime_error( error );
+   }
+   return mysql;
+}
+
+ConnectionLease::ConnectionLease( ConnectionLease&& other ) noexcept
+    : pool( other.pool ), connection( other.connection ), broken( other.broken ) {
+   other.connection = nullptr;
+}
+
+ConnectionLease& ConnectionLease::operator=( ConnectionLease&& other ) noexcept {
+   if ( this != &other ) {
+      release();
+      pool = other.pool;
+      connection = other.connection;
+      broken = other.broken;
+      other.connection = nullptr;
+   }
+   return *this;
+}
+
+ConnectionLease::~ConnectionLease() { release(); }
+
+void ConnectionLease::release() {
+   if ( connection ) {
+      pool->giveBack( connection, broken );
+      connection = nullptr;
+   }
+}
+
+ConnectionPool::ConnectionPool( ConnectionOptions _options, size_t _maxSize, size_t minSize,
+                                size_t _statementCacheCapacity,
+                                std::chrono::milliseconds _healthCheckAfter )
+    : options( std::move( _options ) ),
+      maxSize( _maxSize ),
+      statementCacheCapacity( _statementCacheCapacity ),
+      healthCheckAfter( _healthCheckAfter ),
+      open( 0 ) {
+   if ( !maxSize || minSize > maxSize ) {
+      throw std::runtime_error( "ConnectionPool needs 0 < maxSize and minSize <= maxSize\n" );
+   }
+   // opened up front so the first requests do not pay for the handshake
+   idle.reserve( maxSize );
+   try {
+      for ( ; open < minSize; ++open ) {
+         idle.push_back( connect() );
+      }
+   } catch ( ... ) {
+      for ( auto& connection : idle ) {
+         close( std::move( connection ) );
+      }
+      throw;
+   }
+}
+
+ConnectionPool::~ConnectionPool() {
+   for ( auto& connection : idle ) {
+      close( std::move( connection ) );
+   }
+}
+
+std::unique_ptr<PooledConnection> ConnectionPool::connect() {
+   auto connection = std::make_unique<PooledConnection>();
+   connection->mysql = openConnection( options );
+   connection->statements =
+       std::make_unique<StatementCache>( connection->mysql, statementCacheCapacity );
+   connection->lastUsed = std::chrono::steady_clock::now();
+   connection->lastOwner = std::this_thread::get_id();
+   return connection;
+}
+
+void ConnectionPool::close( std::unique_ptr<PooledConnection> connection ) {
+   // the statements have to be closed while their connection is still open
+   connection->statements.reset();
+   mysql_close( connection->mysql );
+}
+
+// Called unlocked with a slot already counted in open, gives the slot back if connecting fails
+ConnectionLease ConnectionPool::leaseNew() {
+   try {
+      return ConnectionLease( this, connect().release() );
+   } catch ( ... ) {
+      std::lock_guard<std::mutex> guard( mutex );
+      --open;
+      returned.notify_one();
+      throw;
+   }
+}
+
+ConnectionLease ConnectionPool::leaseIdle( std::unique_lock<std::mutex>& lock ) {
+   // the connection this thread used last if it is idle, else the most recently returned one
+   auto found = std::find_if( idle.begin(), idle.end(), [ & ]( const auto& connection ) {
+      return connection->lastOwner == std::this_thread::get_id();
+   } );
+   if ( found == idle.end() ) {
+      found = idle.end() - 1;
+   }
+   std::unique_ptr<PooledConnection> connection = std::move( *found );
+   idle.erase( found );
+   lock.unlock();
+   return checked( std::move( connection ) );
+}
+
+ConnectionLease ConnectionPool::checked( std::unique_ptr<PooledConnection> connection ) {
+   if ( std::chrono::steady_clock::now() - connection->lastUsed > healthCheckAfter &&
+        mysql_ping( connection->mysql ) ) {
+      close( std::move( connection ) );
+      return leaseNew();
+   }
+   return ConnectionLease( this, connection.release() );
+}
+
+void ConnectionPool::giveBack( PooledConnection* connection, bool broken ) {
+   std::unique_ptr<PooledConnection> owned( connection );
+   if ( broken ) {
+      close( std::move( owned ) );
+      std::lock_guard<std::mutex> guard( mutex );
+      --open;
+      returned.notify_one();
+      return;
+   }
+   owned->lastUsed = std::chrono::steady_clock::now();
+   owned->lastOwner = std::this_thread::get_id();
+   std::lock_guard<std::mutex> guard( mutex );
+   idle.push_back( std::move( owned ) );
+   returned.notify_one();
+}
+
+ConnectionLease ConnectionPool::lease() {
+   std::unique_lock<std::mutex> lock( mutex );
+   returned.wait( lock, [ & ] { return !idle.empty() || open < maxSize; } );
+   if ( !idle.empty() ) {
+      return leaseIdle( lock );
+   }
+   ++open;
+   lock.unlock();
+   return leaseNew();
+}
+
+std::optional<ConnectionLease> ConnectionPool::tryLease( std::chrono::milliseconds timeout ) {
+   std::unique_lock<std::mutex> lock( mutex );
+   if ( !returned.wait_for( lock, timeout, [ & ] { return !idle.empty() || open < maxSize; } ) ) {
+      return std::nullopt;
+   }
+   if ( !idle.empty() ) {
+      return leaseIdle( lock );
+   }
+   ++open;
+   lock.unlock();
+   return leaseNew();
+}
+
+size_t ConnectionPool::size() {
+   std::lock_guard<std::mutex> guard( mutex );
+   return open;
+}
+
+size_t ConnectionPool::idleCount() {
+   std::lock_guard<std::mutex> guard( mutex );
+   return idle.size();
+}
+
+}  // namespace set_mysql_binds
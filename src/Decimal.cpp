@@ -0,0 +1,480 @@
+#include "Decimal.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <immintrin.h>
+#endif
+
+#include "SqlTypes/TextFormat.hpp"
+#include "utilities.h"
+
+namespace set_mysql_binds {
+
+namespace {
+
+constexpr std::uint64_t tenPow16 = 10000000000000000ULL;
+constexpr std::uint64_t tenPow18 = 1000000000000000000ULL;
+
+template <typename Rep>
+constexpr Rep powerOfTen( unsigned int exponent ) {
+   Rep power = 1;
+   for ( unsigned int i = 0; i < exponent; ++i ) {
+      power *= 10;
+   }
+   return power;
+}
+
+template <typename Rep>
+using UnsignedRep =
+    std::conditional_t<std::same_as<Rep, int128>, unsigned __int128, std::uint64_t>;
+
+// The general parser, for any text the server or a user may give
+template <typename Rep>
+bool parseUnscaled( std::string_view text, unsigned int scale, unsigned int precision,
+                    Rep& unscaled ) {
+   bool negative = false;
+   if ( !text.empty() && ( text.front() == '-' || text.front() == '+' ) ) {
+      negative = text.front() == '-';
+      text.remove_prefix( 1 );
+   }
+   Rep value = 0;
+   unsigned int fraction = 0;
+   bool point = false;
+   bool anyDigit = false;
+   for ( char c : text ) {
+      if ( c == '.' && !point ) {
+         point = true;
+         continue;
+      }
+      if ( c < '0' || c > '9' || ( point && ++fraction > scale ) ) {
+         return false;
+      }
+      anyDigit = true;
+      if ( __builtin_mul_overflow( value, 10, &value ) ||
+           __builtin_add_overflow( value, c - '0', &value ) ) {
+         return false;
+      }
+   }
+   for ( ; fraction < scale; ++fraction ) {
+      if ( __builtin_mul_overflow( value, 10, &value ) ) {
+         return false;
+      }
+   }
+   if ( !anyDigit || value >= powerOfTen<Rep>( precision ) ) {
+      return false;
+   }
+   unscaled = negative ? -value : value;
+   return true;
+}
+
+// Lays the digits of text, a DECIMAL of scale as the server writes it ([-]digits[.scale digits]),
+// out as exactly width ASCII digits, right aligned behind '0's and without the point. Returns
+// false for any other text, which is left to parseUnscaled().
+bool layoutDigits( std::string_view text, unsigned int scale, char* block, size_t width,
+                   bool& negative ) {
+   negative = !text.empty() && text.front() == '-';
+   if ( negative ) {
+      text.remove_prefix( 1 );
+   }
+   if ( text.size() < scale + 1 ) {
+      return false;
+   }
+   size_t integer = scale ? text.size() - scale - 1 : text.size();
+   if ( integer + scale > width || ( scale && text[ integer ] != '.' ) ) {
+      return false;
+   }
+   std::memset( block, '0', width );
+   std::memcpy( block + width - scale - integer, text.data(), integer );
+   std::memcpy( block + width - scale, text.data() + integer + 1, scale );
+   return true;
+}
+
+// 16 ASCII digits to their value, false when one is not a digit
+bool digits16Scalar( const char* block, std::uint64_t& value ) {
+   value = 0;
+   for ( size_t i = 0; i < 16; ++i ) {
+      unsigned int digit = static_cast<unsigned char>( block[ i ] - '0' );
+      if ( digit > 9 ) {
+         return false;
+      }
+      value = value * 10 + digit;
+   }
+   return true;
+}
+
+// Digits left of the point move one byte right over it, per scale up to 14, so the 16 bytes
+// ending a value hold its digits contiguous at the back
+constexpr size_t maxTailScale = 14;
+alignas( 16 ) constexpr std::array<std::array<char, 16>, maxTailScale + 1> pointShuffles = [] {
+   std::array<std::array<char, 16>, maxTailScale + 1> shuffles{};
+   for ( size_t scale = 0; scale <= maxTailScale; ++scale ) {
+      for ( size_t j = 0; j < 16; ++j ) {
+         if ( !scale || j > 15 - scale ) {
+            shuffles[ scale ][ j ] = static_cast<char>( j );
+         } else {
+            shuffles[ scale ][ j ] = j ? static_cast<char>( j - 1 ) : static_cast<char>( 0x80 );
+         }
+      }
+   }
+   return shuffles;
+}();
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+
+// Digit pairs, then groups of 4 and 8 digits, are combined by multiply-adds across the lanes
+__attribute__( ( target( "sse4.1" ) ) ) inline bool asciiToValue( __m128i ascii,
+                                                                  std::uint64_t& value ) {
+   __m128i digits = _mm_sub_epi8( ascii, _mm_set1_epi8( '0' ) );
+   // a byte that is not a digit wraps to above 9
+   __m128i nine = _mm_set1_epi8( 9 );
+   if ( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_max_epu8( digits, nine ), nine ) ) != 0xFFFF ) {
+      return false;
+   }
+   __m128i pairs = _mm_maddubs_epi16( digits, _mm_set1_epi16( 0x010A ) );
+   __m128i quads = _mm_madd_epi16( pairs, _mm_set1_epi32( 0x00010064 ) );
+   __m128i packed = _mm_packus_epi32( quads, quads );
+   __m128i octets = _mm_madd_epi16( packed, _mm_set1_epi32( 0x00012710 ) );
+   value = static_cast<std::uint64_t>( _mm_cvtsi128_si32( octets ) ) * 100000000ULL +
+           static_cast<std::uint32_t>( _mm_extract_epi32( octets, 1 ) );
+   return true;
+}
+
+// The same on two lanes, lane 0 to first and lane 1 to second
+__attribute__( ( target( "avx2" ) ) ) inline bool asciiToValues( __m256i ascii,
+                                                                 std::uint64_t& first,
+                                                                 std::uint64_t& second ) {
+   __m256i digits = _mm256_sub_epi8( ascii, _mm256_set1_epi8( '0' ) );
+   __m256i nine = _mm256_set1_epi8( 9 );
+   if ( static_cast<unsigned int>( _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8( _mm256_max_epu8( digits, nine ), nine ) ) ) != 0xFFFFFFFFU ) {
+      return false;
+   }
+   __m256i pairs = _mm256_maddubs_epi16( digits, _mm256_set1_epi16( 0x010A ) );
+   __m256i quads = _mm256_madd_epi16( pairs, _mm256_set1_epi32( 0x00010064 ) );
+   __m256i packed = _mm256_packus_epi32( quads, quads );
+   __m256i octets = _mm256_madd_epi16( packed, _mm256_set1_epi32( 0x00012710 ) );
+   auto dword = []( int value ) {
+      return static_cast<std::uint64_t>( static_cast<std::uint32_t>( value ) );
+   };
+   first = dword( _mm256_extract_epi32( octets, 0 ) ) * 100000000ULL +
+           dword( _mm256_extract_epi32( octets, 1 ) );
+   second = dword( _mm256_extract_epi32( octets, 4 ) ) * 100000000ULL +
+            dword( _mm256_extract_epi32( octets, 5 ) );
+   return true;
+}
+
+__attribute__( ( target( "sse4.1" ) ) ) bool digits16Sse41( const char* block,
+                                                            std::uint64_t& value ) {
+   return asciiToValue( _mm_loadu_si128( reinterpret_cast<const __m128i*>( block ) ), value );
+}
+
+// Two blocks of 16 digits at once, block[ 0, 16 ) to first and block[ 16, 32 ) to second
+__attribute__( ( target( "avx2" ) ) ) bool digits32Avx2( const char* block, std::uint64_t& first,
+                                                         std::uint64_t& second ) {
+   return asciiToValues( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( block ) ), first,
+                         second );
+}
+
+// The 16 bytes ending at end, digits of them (after the point is shuffled out) being the value
+__attribute__( ( target( "sse4.1" ) ) ) inline __m128i tailDigits( const char* end,
+                                                                   unsigned int digits,
+                                                                   unsigned int scale ) {
+   __m128i text = _mm_loadu_si128( reinterpret_cast<const __m128i*>( end - 16 ) );
+   text = _mm_shuffle_epi8(
+       text, _mm_load_si128( reinterpret_cast<const __m128i*>( pointShuffles[ scale ].data() ) ) );
+   __m128i keep = _mm_cmpgt_epi8(
+       _mm_setr_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ),
+       _mm_set1_epi8( static_cast<char>( 15 - static_cast<int>( digits ) ) ) );
+   return _mm_blendv_epi8( _mm_set1_epi8( '0' ), text, keep );
+}
+
+__attribute__( ( target( "sse4.1" ) ) ) bool tail16Sse41( const char* end, unsigned int digits,
+                                                          unsigned int scale,
+                                                          std::uint64_t& value ) {
+   return asciiToValue( tailDigits( end, digits, scale ), value );
+}
+
+__attribute__( ( target( "avx2" ) ) ) bool tail32Avx2( const char* firstEnd,
+                                                       unsigned int firstDigits,
+                                                       const char* secondEnd,
+                                                       unsigned int secondDigits,
+                                                       unsigned int scale, std::uint64_t& first,
+                                                       std::uint64_t& second ) {
+   __m256i both = _mm256_inserti128_si256(
+       _mm256_castsi128_si256( tailDigits( firstEnd, firstDigits, scale ) ),
+       tailDigits( secondEnd, secondDigits, scale ), 1 );
+   return asciiToValues( both, first, second );
+}
+
+#endif
+
+DecimalIsa supportedIsa( DecimalIsa isa ) {
+   static const DecimalIsa best = [] {
+#if defined( __x86_64__ ) || defined( __i386__ )
+      __builtin_cpu_init();
+      if ( __builtin_cpu_supports( "avx2" ) ) {
+         return DecimalIsa::Avx2;
+      }
+      if ( __builtin_cpu_supports( "sse4.1" ) ) {
+         return DecimalIsa::Sse41;
+      }
+#endif
+      return DecimalIsa::Scalar;
+   }();
+   return std::min( isa, best );
+}
+
+bool digits16( const char* block, std::uint64_t& value, DecimalIsa isa ) {
+#if defined( __x86_64__ ) || defined( __i386__ )
+   if ( isa != DecimalIsa::Scalar ) {
+      return digits16Sse41( block, value );
+   }
+#endif
+   return digits16Scalar( block, value );
+}
+
+bool digits32( const char* block, std::uint64_t& first, std::uint64_t& second, DecimalIsa isa ) {
+#if defined( __x86_64__ ) || defined( __i386__ )
+   if ( isa == DecimalIsa::Avx2 ) {
+      return digits32Avx2( block, first, second );
+   }
+#endif
+   return digits16( block, first, isa ) && digits16( block + 16, second, isa );
+}
+
+// One value through the smallest block it fits, the general parser for text that fits none or
+// is not in the server's form after all
+template <typename Rep>
+bool decodeOne( std::string_view text, unsigned int scale, Rep& value, DecimalIsa isa ) {
+   alignas( 32 ) char block[ 32 ];
+   bool negative;
+   std::uint64_t high, low;
+   if ( layoutDigits( text, scale, block, 16, negative ) && digits16( block, low, isa ) ) {
+      value = static_cast<Rep>( low );
+   } else if ( layoutDigits( text, scale, block + 14, 18, negative ) ) {
+      // 17 or 18 digits behind 14 '0's fill a 32 digit block, as many as Decimal holds
+      std::memset( block, '0', 14 );
+      if ( !digits32( block, high, low, isa ) ) {
+         return parseUnscaled( text, scale, BasicDecimal<Rep>::maxPrecision, value );
+      }
+      value = static_cast<Rep>( high ) * static_cast<Rep>( tenPow16 ) + static_cast<Rep>( low );
+   } else if ( std::same_as<Rep, int128> && layoutDigits( text, scale, block, 32, negative ) &&
+               digits32( block, high, low, isa ) ) {
+      value = static_cast<Rep>( high ) * static_cast<Rep>( tenPow16 ) + static_cast<Rep>( low );
+   } else {
+      return parseUnscaled( text, scale, BasicDecimal<Rep>::maxPrecision, value );
+   }
+   if ( negative ) {
+      value = -value;
+   }
+   return true;
+}
+
+// Whether text is in the server's form with at most 15 digits (16 without a point) and ends at
+// least 16 bytes into the buffer at bufferStart, so the 16 bytes ending it can be loaded at once
+bool tailForm( std::string_view text, unsigned int scale, const char* bufferStart, bool& negative,
+               unsigned int& digits ) {
+   if ( !bufferStart || scale > maxTailScale || text.data() + text.size() - bufferStart < 16 ) {
+      return false;
+   }
+   negative = !text.empty() && text.front() == '-';
+   size_t body = text.size() - negative;
+   if ( body < scale + 1 ) {
+      return false;
+   }
+   size_t integer = scale ? body - scale - 1 : body;
+   if ( integer + scale > ( scale ? 15U : 16U ) ||
+        ( scale && text[ negative + integer ] != '.' ) ) {
+      return false;
+   }
+   digits = static_cast<unsigned int>( integer + scale );
+   return true;
+}
+
+template <typename Rep>
+void storeValue( Rep& out, std::uint64_t value, bool negative ) {
+   out = negative ? -static_cast<Rep>( value ) : static_cast<Rep>( value );
+}
+
+// textAt( row ) is the text of a row, isValid( row ) false for NULL rows. The texts lie in one
+// buffer starting at bufferStart, nullptr when they do not.
+template <typename Rep, typename TextAt, typename IsValid>
+size_t decodeRows( size_t rows, unsigned int scale, std::span<Rep> out, DecimalIsa isa,
+                   const char* bufferStart, TextAt textAt, IsValid isValid ) {
+   if ( out.size() < rows ) {
+      throw std::out_of_range( "decodeDecimals() output holds fewer values than rows\n" );
+   }
+   isa = supportedIsa( isa );
+   if ( isa == DecimalIsa::Scalar ) {
+      bufferStart = nullptr;
+   }
+   for ( size_t row = 0; row < rows; ) {
+      if ( !isValid( row ) ) {
+         out[ row++ ] = 0;
+         continue;
+      }
+      std::string_view text = textAt( row );
+      bool negative[ 2 ];
+      unsigned int digits[ 2 ];
+      std::uint64_t values[ 2 ];
+#if defined( __x86_64__ ) || defined( __i386__ )
+      if ( tailForm( text, scale, bufferStart, negative[ 0 ], digits[ 0 ] ) ) {
+         // With AVX2 the next value shares the conversion when it is in the same form
+         if ( isa == DecimalIsa::Avx2 && row + 1 < rows && isValid( row + 1 ) ) {
+            std::string_view next = textAt( row + 1 );
+            if ( tailForm( next, scale, bufferStart, negative[ 1 ], digits[ 1 ] ) &&
+                 tail32Avx2( text.data() + text.size(), digits[ 0 ], next.data() + next.size(),
+                             digits[ 1 ], scale, values[ 0 ], values[ 1 ] ) ) {
+               storeValue( out[ row ], values[ 0 ], negative[ 0 ] );
+               storeValue( out[ row + 1 ], values[ 1 ], negative[ 1 ] );
+               row += 2;
+               continue;
+            }
+         }
+         if ( tail16Sse41( text.data() + text.size(), digits[ 0 ], scale, values[ 0 ] ) ) {
+            storeValue( out[ row++ ], values[ 0 ], negative[ 0 ] );
+            continue;
+         }
+      }
+#endif
+      if ( !decodeOne( text, scale, out[ row ], isa ) ) {
+         return row;
+      }
+      ++row;
+   }
+   return rows;
+}
+
+template <typename Rep>
+char* formatUnscaled( char* out, Rep unscaled, unsigned int scale ) {
+   using Unsigned = UnsignedRep<Rep>;
+   Unsigned magnitude = unscaled < 0 ? Unsigned( 0 ) - static_cast<Unsigned>( unscaled )
+                                     : static_cast<Unsigned>( unscaled );
+   // digits are written backwards from the end of text, 18 at a time for an __int128
+   char text[ maxDecimalTextSize ];
+   char* begin = text + sizeof( text );
+   for ( ;; ) {
+      std::uint64_t chunk = static_cast<std::uint64_t>( magnitude % tenPow18 );
+      magnitude /= tenPow18;
+      char* chunkEnd = begin;
+      for ( ; chunk >= 100; chunk /= 100 ) {
+         begin -= 2;
+         std::memcpy( begin, &detail::digitPairs[ 2 * ( chunk % 100 ) ], 2 );
+      }
+      if ( chunk >= 10 ) {
+         begin -= 2;
+         std::memcpy( begin, &detail::digitPairs[ 2 * chunk ], 2 );
+      } else {
+         *--begin = static_cast<char>( '0' + chunk );
+      }
+      if ( !magnitude ) {
+         break;
+      }
+      while ( chunkEnd - begin < 18 ) {
+         *--begin = '0';
+      }
+   }
+   size_t digits = static_cast<size_t>( text + sizeof( text ) - begin );
+   if ( unscaled < 0 ) {
+      *out++ = '-';
+   }
+   if ( digits <= scale ) {
+      *out++ = '0';
+      if ( scale ) {
+         *out++ = '.';
+         std::memset( out, '0', scale - digits );
+         out += scale - digits;
+      }
+      std::memcpy( out, begin, digits );
+      return out + digits;
+   }
+   std::memcpy( out, begin, digits - scale );
+   out += digits - scale;
+   if ( scale ) {
+      *out++ = '.';
+      std::memcpy( out, begin + digits - scale, scale );
+      out += scale;
+   }
+   return out;
+}
+
+}  // namespace
+
+bool parseDecimal( std::string_view text, Decimal& value ) {
+   return parseUnscaled( text, value.scale, value.precision, value.unscaled );
+}
+
+bool parseDecimal( std::string_view text, Decimal128& value ) {
+   return parseUnscaled( text, value.scale, value.precision, value.unscaled );
+}
+
+char* formatDecimal( char* out, const Decimal& value ) {
+   return formatUnscaled( out, value.unscaled, value.scale );
+}
+
+char* formatDecimal( char* out, const Decimal128& value ) {
+   return formatUnscaled( out, value.unscaled, value.scale );
+}
+
+// A DECIMAL's inType is a double, setText() would round the value through it
+static void checkDecimalColumn( const InputCType& column ) {
+   if ( !isCharArray( column.bufferType ) ) {
+      throw std::runtime_error( "setDecimal() on column " + std::string( column.fieldName ) +
+                                ", which is not a char[] column and cannot hold it exactly\n" );
+   }
+}
+
+bool setDecimal( InputCType& column, const Decimal& value ) {
+   checkDecimalColumn( column );
+   char text[ maxDecimalTextSize ];
+   return column.setText( { text, formatDecimal( text, value ) } );
+}
+
+bool setDecimal( InputCType& column, const Decimal128& value ) {
+   checkDecimalColumn( column );
+   char text[ maxDecimalTextSize ];
+   return column.setText( { text, formatDecimal( text, value ) } );
+}
+
+DecimalIsa bestDecimalIsa() {
+   return supportedIsa( DecimalIsa::Best );
+}
+
+size_t decodeDecimals( const ColumnarColumn& column, size_t rows, unsigned int scale,
+                       std::span<std::int64_t> out, DecimalIsa isa ) {
+   return decodeRows(
+       rows, scale, out, isa, reinterpret_cast<const char*>( column.data.data() ),
+       [ & ]( size_t row ) { return column.string( row ); },
+       [ & ]( size_t row ) { return column.isValid( row ); } );
+}
+
+size_t decodeDecimals( const ColumnarColumn& column, size_t rows, unsigned int scale,
+                       std::span<int128> out, DecimalIsa isa ) {
+   return decodeRows(
+       rows, scale, out, isa, reinterpret_cast<const char*>( column.data.data() ),
+       [ & ]( size_t row ) { return column.string( row ); },
+       [ & ]( size_t row ) { return column.isValid( row ); } );
+}
+
+size_t decodeDecimals( std::span<const std::string_view> texts, unsigned int scale,
+                       std::span<std::int64_t> out, DecimalIsa isa ) {
+   return decodeRows(
+       texts.size(), scale, out, isa, nullptr, [ & ]( size_t row ) { return texts[ row ]; },
+       []( size_t ) { return true; } );
+}
+
+size_t decodeDecimals( std::span<const std::string_view> texts, unsigned int scale,
+                       std::span<int128> out, DecimalIsa isa ) {
+   return decodeRows(
+       texts.size(), scale, out, isa, nullptr, [ & ]( size_t row ) { return texts[ row ]; },
+       []( size_t ) { return true; } );
+}
+
+}  // namespace set_mysql_binds
@@ -0,0 +1,98 @@
+#include "EventLoop.h"
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace set_mysql_binds {
+
+// Coroutine frame that owns a spawned Task, started eagerly and freed when it completes
+struct EventLoop::Detached {
+   struct promise_type {
+      Detached get_return_object() const noexcept { return {}; }
+      std::suspend_never initial_suspend() const noexcept { return {}; }
+      std::suspend_never final_suspend() const noexcept { return {}; }
+      void return_void() const noexcept {}
+      void unhandled_exception() const noexcept { std::terminate(); }
+   };
+};
+
+EventLoop::EventLoop() : epollFd( epoll_create1( EPOLL_CLOEXEC ) ), running( 0 ), waiting( 0 ) {
+   if ( epollFd < 0 ) {
+      throw std::runtime_error( std::string( "epoll_create1() failed: " ) +
+                                std::strerror( errno ) );
+   }
+}
+
+EventLoop::~EventLoop() { close( epollFd ); }
+
+void EventLoop::watch( int fd, std::uint32_t events, std::coroutine_handle<> handle ) {
+   epoll_event event{};
+   event.events = events | EPOLLONESHOT;
+   event.data.ptr = handle.address();
+   // a one shot fd stays registered, disarmed, after it fired once
+   if ( epoll_ctl( epollFd, EPOLL_CTL_MOD, fd, &event ) &&
+        ( errno != ENOENT || epoll_ctl( epollFd, EPOLL_CTL_ADD, fd, &event ) ) ) {
+      throw std::runtime_error( std::string( "epoll_ctl() failed: " ) + std::strerror( errno ) );
+   }
+   ++waiting;
+}
+
+EventLoop::Detached EventLoop::runDetached( Task<void> task ) {
+   co_await schedule();
+   try {
+      co_await task;
+   } catch ( ... ) {
+      if ( !firstError ) {
+         firstError = std::current_exception();
+      }
+   }
+   --running;
+}
+
+void EventLoop::spawn( Task<void> task ) {
+   ++running;
+   runDetached( std::move( task ) );
+}
+
+void EventLoop::run() {
+   constexpr int maxEvents = 64;
+   epoll_event events[ maxEvents ];
+   while ( running ) {
+      while ( !ready.empty() ) {
+         std::coroutine_handle<> handle = ready.front();
+         ready.pop_front();
+         handle.resume();
+      }
+      if ( !running ) {
+         break;
+      }
+      if ( !waiting ) {
+         throw std::runtime_error(
+             "EventLoop tasks are suspended on something other than the loop\n" );
+      }
+
+      int count = epoll_wait( epollFd, events, maxEvents, -1 );
+      if ( count < 0 ) {
+         if ( errno == EINTR ) {
+            continue;
+         }
+         throw std::runtime_error( std::string( "epoll_wait() failed: " ) +
+                                   std::strerror( errno ) );
+      }
+      for ( int i = 0; i < count; ++i ) {
+         --waiting;
+         ready.push_back( std::coroutine_handle<>::from_address( events[ i ].data.ptr ) );
+      }
+   }
+
+   if ( firstError ) {
+      std::rethrow_exception( std::exchange( firstError, nullptr ) );
+   }
+}
+
+}  // namespace set_mysql_binds
@@ -0,0 +1,96 @@
+#include "MysqlTime.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "utilities.h"
+
+namespace set_mysql_binds {
+
+namespace {
+
+enum class TimeKind { Date, DateTime, Time };
+
+TimeKind timeKind( enum_field_types type ) {
+   switch ( type ) {
+      case MYSQL_TYPE_DATE:
+         return TimeKind::Date;
+      case MYSQL_TYPE_DATETIME:
+      case MYSQL_TYPE_TIMESTAMP:
+         return TimeKind::DateTime;
+      case MYSQL_TYPE_TIME:
+         return TimeKind::Time;
+      default:
+         throw std::runtime_error( "No epoch count for a column of type " +
+                                   std::string( fieldTypes[ type ] ) + '\n' );
+   }
+}
+
+// One loop per kind so the loops hold no branch, valid( i ) all ones or 0 to mask NULL rows
+template <typename Valid>
+void convertTimes( std::span<const MYSQL_TIME> times, TimeKind kind, std::span<std::int64_t> out,
+                   Valid valid ) {
+   if ( out.size() < times.size() ) {
+      throw std::out_of_range( "toEpochValues() output holds fewer values than times\n" );
+   }
+   const size_t rows = times.size();
+   switch ( kind ) {
+      case TimeKind::Date:
+         for ( size_t i = 0; i < rows; ++i ) {
+            out[ i ] = toSysDays( times[ i ] ).time_since_epoch().count() & valid( i );
+         }
+         break;
+      case TimeKind::DateTime:
+         for ( size_t i = 0; i < rows; ++i ) {
+            out[ i ] = toSysTime( times[ i ] ).time_since_epoch().count() & valid( i );
+         }
+         break;
+      case TimeKind::Time:
+         for ( size_t i = 0; i < rows; ++i ) {
+            out[ i ] = toDuration( times[ i ] ).count() & valid( i );
+         }
+         break;
+   }
+}
+
+}  // namespace
+
+void toEpochValues( std::span<const MYSQL_TIME> times, enum_field_types type,
+                    std::span<std::int64_t> out ) {
+   convertTimes( times, timeKind( type ), out, []( size_t ) { return std::int64_t{ -1 }; } );
+}
+
+void toEpochValues( const ColumnarColumn& column, size_t rows, std::span<std::int64_t> out ) {
+   const TimeKind kind = timeKind( column.bufferType );
+   convertTimes( column.values<MYSQL_TIME>( rows ), kind, out, [ & ]( size_t row ) {
+      return -static_cast<std::int64_t>( ( column.validity[ row / 8 ] >> ( row % 8 ) ) & 1 );
+   } );
+}
+
+void fromEpochValues( std::span<const std::int64_t> values, enum_field_types type,
+                      std::span<MYSQL_TIME> times ) {
+   if ( times.size() < values.size() ) {
+      throw std::out_of_range( "fromEpochValues() output holds fewer times than values\n" );
+   }
+   const size_t rows = values.size();
+   switch ( timeKind( type ) ) {
+      case TimeKind::Date:
+         for ( size_t i = 0; i < rows; ++i ) {
+            times[ i ] = toMysqlDate( std::chrono::sys_days( std::chrono::days( values[ i ] ) ) );
+         }
+         break;
+      case TimeKind::DateTime:
+         for ( size_t i = 0; i < rows; ++i ) {
+            times[ i ] =
+                toMysqlDateTime( sys_microseconds( std::chrono::microseconds( values[ i ] ) ) );
+         }
+         break;
+      case TimeKind::Time:
+         for ( size_t i = 0; i < rows; ++i ) {
+            times[ i ] = toMysqlTime( std::chrono::microseconds( values[ i ] ) );
+         }
+         break;
+   }
+}
+
+}  // namespace set_mysql_binds
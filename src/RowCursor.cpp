@@ -0,0 +1,78 @@
+#include "RowCursor.h"
+
+#include <stdexcept>
+
+namespace set_mysql_binds {
+
+RowCursor::RowCursor( Statement& _statement, BindsArray<OutputCType>& _row,
+                      CursorOptions _options )
+    : statement( _statement ),
+      row( _row ),
+      options( _options ),
+      started( false ),
+      exhausted( false ),
+      closed( false ),
+      fetched( 0 ) {
+   // statements come back from a StatementCache with whatever attributes they were last run with
+   MYSQL_STMT* stmt = statement.handle();
+   unsigned long cursorType =
+       options.mode == FetchMode::ServerCursor ? CURSOR_TYPE_READ_ONLY : CURSOR_TYPE_NO_CURSOR;
+   unsigned long prefetchRows = options.prefetchRows ? options.prefetchRows : 1;
+   if ( mysql_stmt_attr_set( stmt, STMT_ATTR_CURSOR_TYPE, &cursorType ) ||
+        mysql_stmt_attr_set( stmt, STMT_ATTR_PREFETCH_ROWS, &prefetchRows ) ) {
+      throw std::runtime_error( mysql_stmt_error( stmt ) );
+   }
+
+   statement.bindResults( row );
+   statement.execute();
+   if ( options.mode == FetchMode::Buffered ) {
+      statement.storeResult();
+   }
+}
+
+RowCursor::~RowCursor() {
+   try {
+      close();
+   } catch ( const std::runtime_error& ) {
+      // the connection reports the error again on its next use
+   }
+}
+
+RowCursor::iterator RowCursor::begin() {
+   if ( started ) {
+      throw std::runtime_error( "RowCursor can only be iterated once\n" );
+   }
+   next();
+   return iterator( this );
+}
+
+bool RowCursor::next() {
+   started = true;
+   if ( exhausted ) {
+      return false;
+   }
+   if ( !statement.fetch() ) {
+      exhausted = true;
+      return false;
+   }
+   ++fetched;
+   return true;
+}
+
+void RowCursor::close() {
+   if ( closed ) {
+      return;
+   }
+   bool early = !exhausted;
+   exhausted = true;
+   closed = true;
+   statement.freeResult();
+   if ( early && options.mode == FetchMode::ServerCursor ) {
+      // closes the cursor on the server
+      if ( mysql_stmt_reset( statement.handle() ) ) {
+         throw std::runtime_error( mysql_stmt_error( statement.handle() ) );
+      }
+   }
+}
+
+}  // namespace set_mysql_binds
@@ -0,0 +1,100 @@
+#include "RowWriter.h"
+
+#include <algorithm>
+#include <array>
+
+#include "SqlTypes/TextFormat.hpp"
+
+namespace set_mysql_binds {
+
+// The char after the backslash for each char Tsv escapes, 0 for those written as they are
+static constexpr std::array<char, 256> tsvEscapes = [] {
+   std::array<char, 256> escapes{};
+   escapes[ '\t' ] = 't';
+   escapes[ '\n' ] = 'n';
+   escapes[ '\r' ] = 'r';
+   escapes[ '\\' ] = '\\';
+   escapes[ 0 ] = '0';
+   return escapes;
+}();
+
+RowWriter::RowWriter( std::string& _out, RowFormat _format )
+    : out( _out ), format( _format ), rows( 0 ) {}
+
+void RowWriter::writeNull() {
+   if ( format == RowFormat::Tsv ) {
+      out.append( "\\N" );
+   }
+}
+
+void RowWriter::writeText( std::string_view text ) {
+   if ( format == RowFormat::Csv ) {
+      if ( text.empty() ) {
+         out.append( "\"\"" );
+      } else if ( text.find_first_of( ",\"\r\n" ) == std::string_view::npos ) {
+         out.append( text );
+      } else {
+         out.push_back( '"' );
+         for ( char c : text ) {
+            if ( c == '"' ) {
+               out.push_back( '"' );
+            }
+            out.push_back( c );
+         }
+         out.push_back( '"' );
+      }
+      return;
+   }
+
+   // the runs between characters to escape are appended whole
+   size_t start = 0;
+   for ( size_t i = 0; i < text.size(); ++i ) {
+      char escaped = tsvEscapes[ static_cast<unsigned char>( text[ i ] ) ];
+      if ( !escaped ) {
+         continue;
+      }
+      out.append( text.substr( start, i - start ) );
+      out.push_back( '\\' );
+      out.push_back( escaped );
+      start = i + 1;
+   }
+   out.append( text.substr( start ) );
+}
+
+void RowWriter::writeHeader( std::span<const std::string_view> names ) {
+   char delimiter = format == RowFormat::Csv ? ',' : '\t';
+   for ( size_t i = 0; i < names.size(); ++i ) {
+      if ( i ) {
+         out.push_back( delimiter );
+      }
+      writeText( names[ i ] );
+   }
+   out.push_back( '\n' );
+}
+
+void RowWriter::writeRow( std::span<const MYSQL_BIND> binds ) {
+   char delimiter = format == RowFormat::Csv ? ',' : '\t';
+   for ( size_t i = 0; i < binds.size(); ++i ) {
+      const MYSQL_BIND& bind = binds[ i ];
+      if ( i ) {
+         out.push_back( delimiter );
+      }
+      if ( bind.is_null && *bind.is_null ) {
+         writeNull();
+      } else if ( fixedBufferSize( bind.buffer_type ) ) {
+         // numbers and temporal values never hold a delimiter, quote or escape
+         size_t at = out.size();
+         out.resize( at + maxFixedTextSize );
+         char* end = bindToText( out.data() + at, bind );
+         out.resize( static_cast<size_t>( end - out.data() ) );
+      } else {
+         size_t length = bind.length ? std::min<size_t>( *bind.length, bind.buffer_length )
+                                     : bind.buffer_length;
+         writeText( { static_cast<const char*>( bind.buffer ), length } );
+      }
+   }
+   out.push_back( '\n' );
+   ++rows;
+}
+
+}  // namespace set_mysql_binds
@@ -0,0 +1,274 @@
+#include "SchemaSnapshot.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "ConnectionPool.h"
+
+namespace set_mysql_binds {
+
+static constexpr char snapshotMagic[ 8 ] = { 'S', 'M', 'B', 'S', 'N', 'A', 'P', '\0' };
+static constexpr std::uint32_t snapshotByteOrder = 0x01020304;
+static constexpr std::uint32_t snapshotVersion = 1;
+
+static constexpr std::uint64_t alignTo8( std::uint64_t offset ) { return ( offset + 7 ) & ~7ULL; }
+
+// Whether [ offset, offset + size ) lies within total bytes, without overflowing
+static bool fitsIn( std::uint64_t offset, std::uint64_t size, std::uint64_t total ) {
+   return offset <= total && size <= total - offset;
+}
+
+// Checks every record once, so the views read in place never leave the mapping: the sections lie
+// in the file and are aligned for their records, every string lies in the pool and every table's
+// fields in the field records
+static bool isIntact( const SnapshotHeader& header, const char* base, size_t size ) {
+   if ( std::memcmp( header.magic, snapshotMagic, sizeof( snapshotMagic ) ) ||
+        header.byteOrder != snapshotByteOrder || header.version != snapshotVersion ||
+        header.tablesOffset % alignof( SnapshotTable ) ||
+        header.fieldsOffset % alignof( SnapshotField ) ||
+        !fitsIn( header.tablesOffset,
+                 std::uint64_t{ header.tableCount } * sizeof( SnapshotTable ), size ) ||
+        !fitsIn( header.fieldsOffset,
+                 std::uint64_t{ header.fieldCount } * sizeof( SnapshotField ), size ) ||
+        !fitsIn( header.stringsOffset, header.stringsSize, size ) ) {
+      return false;
+   }
+   const auto* tables = reinterpret_cast<const SnapshotTable*>( base + header.tablesOffset );
+   const auto* fields = reinterpret_cast<const SnapshotField*>( base + header.fieldsOffset );
+   for ( std::uint32_t i = 0; i < header.tableCount; ++i ) {
+      const SnapshotTable& table = tables[ i ];
+      if ( !fitsIn( table.nameOffset, table.nameLength, header.stringsSize ) ||
+           !fitsIn( table.firstField, table.fieldCount, header.fieldCount ) ) {
+         return false;
+      }
+   }
+   for ( std::uint32_t i = 0; i < header.fieldCount; ++i ) {
+      const SnapshotField& field = fields[ i ];
+      if ( !fitsIn( field.nameOffset, field.nameLength, header.stringsSize ) ||
+           !fitsIn( field.externalTypeOffset, field.externalTypeLength, header.stringsSize ) ) {
+         return false;
+      }
+   }
+   return true;
+}
+
+SchemaSnapshot::SchemaSnapshot( const std::string& path )
+    : mapping( nullptr ),
+      mappingSize( 0 ),
+      header( nullptr ),
+      tableRecords( nullptr ),
+      fieldRecords( nullptr ),
+      strings( nullptr ) {
+   int fd = open( path.c_str(), O_RDONLY );
+   if ( fd < 0 ) {
+      return;
+   }
+   struct stat st;
+   if ( fstat( fd, &st ) || static_cast<size_t>( st.st_size ) < sizeof( SnapshotHeader ) ) {
+      close( fd );
+      return;
+   }
+   mappingSize = static_cast<size_t>( st.st_size );
+   mapping = mmap( nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0 );
+   close( fd );
+   if ( mapping == MAP_FAILED ) {
+      mapping = nullptr;
+      return;
+   }
+
+   const auto* base = static_cast<const char*>( mapping );
+   const auto* candidate = reinterpret_cast<const SnapshotHeader*>( base );
+   if ( !isIntact( *candidate, base, mappingSize ) ) {
+      return;
+   }
+   header = candidate;
+   tableRecords = reinterpret_cast<const SnapshotTable*>( base + header->tablesOffset );
+   fieldRecords = reinterpret_cast<const SnapshotField*>( base + header->fieldsOffset );
+   strings = base + header->stringsOffset;
+}
+
+SchemaSnapshot::~SchemaSnapshot() {
+   if ( mapping ) {
+      munmap( mapping, mappingSize );
+   }
+}
+
+std::string_view TableView::name() const {
+   return snapshot->string( record->nameOffset, record->nameLength );
+}
+
+FieldView TableView::field( size_t index ) const {
+   const SnapshotField& f = snapshot->fieldRecords[ record->firstField + index ];
+   return { snapshot->string( f.nameOffset, f.nameLength ),
+            static_cast<enum_field_types>( f.type ),
+            static_cast<unsigned long int>( f.flags ),
+            snapshot->string( f.externalTypeOffset, f.externalTypeLength ),
+            f.maxLength,
+            f.numericPrecision,
+            f.numericScale };
+}
+
+std::vector<Table> SchemaSnapshot::toTables() const {
+   std::vector<Table> tables( tableCount() );
+   for ( size_t i = 0; i < tables.size(); ++i ) {
+      TableView view = table( i );
+      tables[ i ].name = view.name();
+      tables[ i ].fields.reserve( view.fieldCount() );
+      for ( size_t j = 0; j < view.fieldCount(); ++j ) {
+         FieldView f = view.field( j );
+         tables[ i ].fields.emplace_back( std::string( f.name ), f.type, f.flags,
+                                          std::string( f.externalType ), f.maxLength,
+                                          f.numericPrecision, f.numericScale );
+      }
+   }
+   return tables;
+}
+
+void writeSchemaSnapshot( const std::string& path, std::span<const Table> tables,
+                          std::uint64_t fingerprint ) {
+   std::string pool;
+   std::unordered_map<std::string_view, std::uint32_t> interned;
+   auto intern = [ & ]( std::string_view str ) {
+      auto [ it, inserted ] =
+          interned.try_emplace( str, static_cast<std::uint32_t>( pool.size() ) );
+      if ( inserted ) {
+         pool += str;
+      }
+      return it->second;
+   };
+
+   std::vector<SnapshotTable> tableRecords;
+   std::vector<SnapshotField> fieldRecords;
+   tableRecords.reserve( tables.size() );
+   for ( const auto& table : tables ) {
+      tableRecords.push_back( { intern( table.name ),
+                                static_cast<std::uint32_t>( table.name.size() ),
+                                static_cast<std::uint32_t>( fieldRecords.size() ),
+                                static_cast<std::uint32_t>( table.fields.size() ) } );
+      for ( const auto& field : table.fields ) {
+         fieldRecords.push_back( { intern( field.name ),
+                                   static_cast<std::uint32_t>( field.name.size() ),
+                                   intern( field.externalType ),
+                                   static_cast<std::uint32_t>( field.externalType.size() ),
+                                   static_cast<std::uint32_t>( field.type ),
+                                   field.numericPrecision,
+                                   field.numericScale,
+                                   0,
+                                   field.flags,
+                                   field.maxLength } );
+      }
+   }
+
+   SnapshotHeader header{};
+   std::memcpy( header.magic, snapshotMagic, sizeof( snapshotMagic ) );
+   header.byteOrder = snapshotByteOrder;
+   header.version = snapshotVersion;
+   header.fingerprint = fingerprint;
+   header.tableCount = static_cast<std::uint32_t>( tableRecords.size() );
+   header.fieldCount = static_cast<std::uint32_t>( fieldRecords.size() );
+   header.tablesOffset = alignTo8( sizeof( header ) );
+   header.fieldsOffset =
+       alignTo8( header.tablesOffset + tableRecords.size() * sizeof( SnapshotTable ) );
+   header.stringsOffset =
+       alignTo8( header.fieldsOffset + fieldRecords.size() * sizeof( SnapshotField ) );
+   header.stringsSize = pool.size();
+
+   std::string tmpPath = path + ".tmp";
+   {
+      std::ofstream file( tmpPath, std::ios::binary | std::ios::trunc );
+      auto writeAt = [ & ]( std::uint64_t offset, const void* data, size_t size ) {
+         file.seekp( static_cast<std::streamoff>( offset ) );
+         file.write( static_cast<const char*>( data ), static_cast<std::streamsize>( size ) );
+      };
+      writeAt( 0, &header, sizeof( header ) );
+      writeAt( header.tablesOffset, tableRecords.data(),
+               tableRecords.size() * sizeof( SnapshotTable ) );
+      writeAt( header.fieldsOffset, fieldRecords.data(),
+               fieldRecords.size() * sizeof( SnapshotField ) );
+      writeAt( header.stringsOffset, pool.data(), pool.size() );
+      if ( !file ) {
+         throw std::runtime_error( "could not write schema snapshot " + tmpPath + "\n" );
+      }
+   }
+   if ( std::rename( tmpPath.c_str(), path.c_str() ) ) {
+      throw std::runtime_error( "could not rename schema snapshot to " + path + "\n" );
+   }
+}
+
+std::uint64_t getSchemaFingerprint( MYSQL* db_conn ) {
+   static constexpr const char* fingerprintQuery =
+       "SELECT COUNT(*), COALESCE(SUM(c), 0), COALESCE(BIT_XOR(c), 0) FROM (SELECT "
+       "CRC32(CONCAT_WS('|', table_name, ordinal_position, column_name, column_type, is_nullable, "
+       "column_key, extra, IFNULL(character_octet_length, ''), IFNULL(character_set_name, ''), "
+       "IFNULL(collation_name, ''))) AS c FROM information_schema.columns "
+       "WHERE table_schema = DATABASE()) AS definitions";
+
+   MYSQL_RES* res = nullptr;
+   if ( mysql_query( db_conn, fingerprintQuery ) ||
+        ( res = mysql_store_result( db_conn ) ) == nullptr ) {
+      throw std::runtime_error( mysql_error( db_conn ) );
+   }
+
+   // FNV-1a over the three aggregates
+   std::uint64_t hash = 14695981039346656037ULL;
+   MYSQL_ROW row = mysql_fetch_row( res );
+   for ( unsigned int i = 0; row && i < 3; ++i ) {
+      for ( const char* c = row[ i ]; c && *c; ++c ) {
+         hash = ( hash ^ static_cast<unsigned char>( *c ) ) * 1099511628211ULL;
+      }
+      hash = ( hash ^ '|' ) * 1099511628211ULL;
+   }
+   mysql_free_result( res );
+   return hash;
+}
+
+std::uint64_t getSchemaFingerprint( const std::string& host, const std::string& user,
+                                    const std::string& password, const std::string& database ) {
+   MYSQL* db_conn = nullptr;
+   try {
+      db_conn = openConnection( { host, user, password, database } );
+   } catch ( const std::runtime_error& e ) {
+      std::cerr << "Error: " << e.what() << '\n';
+      exit( 1 );
+   }
+
+   std::uint64_t fingerprint = 0;
+   try {
+      fingerprint = getSchemaFingerprint( db_conn );
+   } catch ( const std::runtime_error& e ) {
+      std::cerr << "Error: " << e.what() << '\n';
+      mysql_close( db_conn );
+      exit( 1 );
+   }
+
+   mysql_close( db_conn );
+   return fingerprint;
+}
+
+std::vector<Table> loadDBTables( const std::string& host, const std::string& user,
+                                 const std::string& password, const std::string& database,
+                                 const std::string& snapshotPath ) {
+   std::uint64_t fingerprint = getSchemaFingerprint( host, user, password, database );
+   {
+      SchemaSnapshot snapshot( snapshotPath );
+      if ( snapshot.isValid() && snapshot.fingerprint() == fingerprint ) {
+         return snapshot.toTables();
+      }
+   }
+
+   std::vector<Table> tables = getDBTables( host, user, password, database );
+   writeSchemaSnapshot( snapshotPath, tables, fingerprint );
+   return tables;
+}
+
+}  // namespace set_mysql_binds
@@ -0,0 +1,118 @@
+#include "Statement.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace set_mysql_binds {
+
+Statement::Statement( MYSQL* conn, std::string_view _sql )
+    : stmt( mysql_stmt_init( conn ) ),
+      sql( _sql ),
+      params( nullptr ),
+      results( nullptr ),
+      boundParams( nullptr ),
+      boundParamsVersion( 0 ),
+      boundResults( nullptr ),
+      boundResultsVersion( 0 ) {
+   if ( stmt == nullptr ) {
+      throw std::runtime_error( mysql_error( conn ) );
+   }
+   if ( mysql_stmt_prepare( stmt, sql.c_str(), sql.size() ) ) {
+      std::string error = mysql_stmt_error( stmt );
+      mysql_stmt_close( stmt );
+      throw std::runtime_error( error );
+   }
+}
+
+Statement::~Statement() { mysql_stmt_close( stmt ); }
+
+// Throws when the binds selected are not one per parameter or result column of the statement
+static void checkBindsSize( size_t bindsSize, size_t expected, const char* caller,
+                            const char* what ) {
+   if ( bindsSize != expected ) {
+      throw std::runtime_error( std::string( "BindsArray given to " ) + caller + " has " +
+                                std::to_string( bindsSize ) +
+                                " binds selected for a statement with " +
+                                std::to_string( expected ) + ' ' + what + '\n' );
+   }
+}
+
+void Statement::bindParams( BindsArray<InputCType>& _params ) {
+   checkBindsSize( _params.getBindsSize(), paramCount(), "bindParams()", "parameters" );
+   params = &_params;
+}
+
+void Statement::bindResults( BindsArray<OutputCType>& _results ) {
+   checkBindsSize( _results.getBindsSize(), fieldCount(), "bindResults()", "result columns" );
+   results = &_results;
+}
+
+void Statement::rebind() {
+   boundParams = nullptr;
+   boundResults = nullptr;
+}
+
+// The selection or projection may have changed since bindParams()/bindResults(), so the sizes are
+// checked again before the client library reads the binds
+void Statement::bindIfChanged() {
+   if ( params && ( boundParams != params || boundParamsVersion != params->getBindsVersion() ) ) {
+      checkBindsSize( params->getBindsSize(), paramCount(), "bindParams()", "parameters" );
+      if ( mysql_stmt_bind_param( stmt, params->getBinds() ) ) {
+         throw std::runtime_error( mysql_stmt_error( stmt ) );
+      }
+      boundParams = params;
+      boundParamsVersion = params->getBindsVersion();
+   }
+   if ( results &&
+        ( boundResults != results || boundResultsVersion != results->getBindsVersion() ) ) {
+      checkBindsSize( results->getBindsSize(), fieldCount(), "bindResults()", "result columns" );
+      if ( mysql_stmt_bind_result( stmt, results->getBinds() ) ) {
+         throw std::runtime_error( mysql_stmt_error( stmt ) );
+      }
+      boundResults = results;
+      boundResultsVersion = results->getBindsVersion();
+   }
+}
+
+void Statement::execute() {
+   if ( paramCount() && params == nullptr ) {
+      throw std::runtime_error( "Statement executed without bindParams(): " + sql + '\n' );
+   }
+   bindIfChanged();
+   if ( mysql_stmt_execute( stmt ) ) {
+      throw std::runtime_error( mysql_stmt_error( stmt ) );
+   }
+}
+
+bool Statement::fetch() {
+   if ( results == nullptr ) {
+      throw std::runtime_error( "Statement fetched without bindResults(): " + sql + '\n' );
+   }
+   bindIfChanged();
+   int status = mysql_stmt_fetch( stmt );
+   if ( status == MYSQL_NO_DATA ) {
+      return false;
+   }
+   if ( status == MYSQL_DATA_TRUNCATED ) {
+      // refetchTruncated() binds the result again itself
+      results->refetchTruncated( stmt );
+      boundResultsVersion = results->getBindsVersion();
+   } else if ( status ) {
+      throw std::runtime_error( mysql_stmt_error( stmt ) );
+   }
+   return true;
+}
+
+void Statement::storeResult() {
+   if ( mysql_stmt_store_result( stmt ) ) {
+      throw std::runtime_error( mysql_stmt_error( stmt ) );
+   }
+}
+
+void Statement::freeResult() {
+   if ( mysql_stmt_free_result( stmt ) ) {
+      throw std::runtime_error( mysql_stmt_error( stmt ) );
+   }
+}
+
+}  // namespace set_mysql_binds
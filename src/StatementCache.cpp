@@ -0,0 +1,49 @@
+#include "StatementCache.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace set_mysql_binds {
+
+StatementCache::StatementCache( MYSQL* _conn, size_t _capacity )
+    : conn( _conn ), capacity( _capacity ), hitCount( 0 ), missCount( 0 ), evictionCount( 0 ) {
+   if ( !capacity ) {
+      throw std::runtime_error( "StatementCache needs room for at least one statement\n" );
+   }
+   index.reserve( capacity );
+}
+
+Statement& StatementCache::get( std::string_view sql ) {
+   auto found = index.find( sql );
+   if ( found != index.end() ) {
+      ++hitCount;
+      statements.splice( statements.begin(), statements, found->second );
+      return statements.front();
+   }
+
+   ++missCount;
+   // prepared before evicting so a statement that fails to prepare costs no cached one
+   statements.emplace_front( conn, sql );
+   if ( statements.size() > capacity ) {
+      index.erase( statements.back().text() );
+      statements.pop_back();
+      ++evictionCount;
+   }
+   index.emplace( statements.front().text(), statements.begin() );
+   return statements.front();
+}
+
+void StatementCache::warmUp( std::span<const std::string_view> sqls ) {
+   unsigned long long hitsBefore = hitCount;
+   unsigned long long missesBefore = missCount;
+   std::for_each( sqls.begin(), sqls.end(), [ & ]( auto sql ) { get( sql ); } );
+   hitCount = hitsBefore;
+   missCount = missesBefore;
+}
+
+void StatementCache::clear() {
+   index.clear();
+   statements.clear();
+}
+
+}  // namespace set_mysql_binds
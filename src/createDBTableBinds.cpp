@@ -4,18 +4,37 @@
    code files.
 
     The function declarations to a .h/.hpp file and their definitions to a .cpp file using
-    the paths that are specified in the function arguments.
+    the paths that are specified in the function arguments. Each table also gets a <table>Column
+    enum of column IDs and a constexpr <table>FieldHash of its column names that the generated
+    BindsArray functions hand to the binds, so both lookups by name and by ID skip the hash map.
+    Names that are no C++ identifier (keywords, spaces, dashes, a leading digit) are turned into
+    one for the enumerators, row struct members, functions and file names, the string literals
+    keep the names as they are, escaped.
+
+    createDBTableBindsPerTable() instead writes a <table>Binds.h/<table>Binds.cpp pair per table,
+    rendered in parallel, plus a <database>AllBinds.h including all of them and a
+    <database>Binds.cmake manifest of the generated files. Files whose content did not change are
+    left untouched, so a schema change only rebuilds the code of the tables it touched.
 
 */
 
 #include "createDBTableBinds.h"
 
+#include <atomic>
 #include <cctype>
+#include <exception>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 #include <span>
 #include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "BindsArray.hpp"
 #include "getDBTables.h"
@@ -24,16 +43,96 @@
 
 namespace set_mysql_binds {
 
+// Words a column name cannot be as an enumerator or member: the keywords and alternative tokens
+// of C++20 and the macros of the headers a generated file includes
+static bool isReservedWord( std::string_view word ) {
+   static const std::unordered_set<std::string_view> reserved{
+       "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+       "case", "catch", "char", "char8_t", "char16_t", "char32_t", "class", "co_await",
+       "co_return", "co_yield", "compl", "concept", "const", "consteval", "constexpr",
+       "constinit", "const_cast", "continue", "decltype", "default", "delete", "do", "double",
+       "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for",
+       "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept",
+       "not", "not_eq", "nullptr", "operator", "or", "or_eq", "private", "protected", "public",
+       "register", "reinterpret_cast", "requires", "return", "short", "signed", "sizeof",
+       "static", "static_assert", "static_cast", "struct", "switch", "template", "this",
+       "thread_local", "throw", "true", "try", "typedef", "typeid", "typename", "union",
+       "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq",
+       "NULL", "EOF", "errno", "assert", "offsetof", "stdin", "stdout", "stderr" };
+   return reserved.contains( word );
+}
+
+// name as a C++ identifier: characters other than letters, digits and '_' become '_', a leading
+// digit or an empty name gets a '_' in front and a reserved word one behind
+static std::string toIdentifier( std::string_view name ) {
+   std::string identifier;
+   if ( name.empty() || std::isdigit( static_cast<unsigned char>( name.front() ) ) ) {
+      identifier += '_';
+   }
+   std::transform( name.begin(), name.end(), std::back_inserter( identifier ), []( char c ) {
+      return std::isalnum( static_cast<unsigned char>( c ) ) ? c : '_';
+   } );
+   if ( isReservedWord( identifier ) ) {
+      identifier += '_';
+   }
+   return identifier;
+}
+
+// The identifiers of a table's columns, made unique with trailing '_'s where two names map to the
+// same one. A column's row struct members <name>_length and <name>_isNull are taken as well.
+static std::vector<std::string> fieldIdentifiers( const Table& table ) {
+   std::unordered_set<std::string> taken;
+   std::vector<std::string> identifiers;
+   for ( const auto& field : table.fields ) {
+      std::string identifier = toIdentifier( field.name );
+      while ( taken.contains( identifier ) || taken.contains( identifier + "_length" ) ||
+              taken.contains( identifier + "_isNull" ) ) {
+         identifier += '_';
+      }
+      taken.insert( identifier );
+      taken.insert( identifier + "_length" );
+      taken.insert( identifier + "_isNull" );
+      identifiers.push_back( std::move( identifier ) );
+   }
+   return identifiers;
+}
+
+// text as a C++ string literal, quotes included
+static std::string toStringLiteral( std::string_view text ) {
+   std::string literal( 1, '"' );
+   for ( char c : text ) {
+      if ( c == '"' || c == '\\' ) {
+         literal += '\\';
+         literal += c;
+      } else if ( std::isprint( static_cast<unsigned char>( c ) ) ) {
+         literal += c;
+      } else {
+         // three octal digits, so a following digit does not extend the escape
+         unsigned int byte = static_cast<unsigned char>( c );
+         literal += '\\';
+         literal += static_cast<char>( '0' + ( byte >> 6 ) );
+         literal += static_cast<char>( '0' + ( ( byte >> 3 ) & 7 ) );
+         literal += static_cast<char>( '0' + ( byte & 7 ) );
+      }
+   }
+   literal += '"';
+   return literal;
+}
+
 static void setDeclHeaderAndFooter( std::ostringstream& declaration_header,
-                                    std::ostringstream& declaration_footer, std::string db_name ) {
+                                    std::ostringstream& declaration_footer,
+                                    const std::string& db_name ) {
+   std::string identifier = toIdentifier( db_name );
    std::string upper_db_name;
-   std::transform( db_name.begin(), db_name.end(), std::back_inserter( upper_db_name ), ::toupper );
+   std::transform( identifier.begin(), identifier.end(), std::back_inserter( upper_db_name ),
+                   ::toupper );
    std::string included_macro = std::string( "INCLUDED_" ) + upper_db_name + "BINDS_H";
 
    declaration_header << "// This file was generated by createDBTableBinds() function\n"
                       << "#ifndef " << included_macro << '\n'
                       << "#define " << included_macro << "\n\n"
-                      << "#include \"BindsArray.hpp\"\n\n\nusing namespace set_mysql_binds;\n\n\n";
+                      << "#include \"BindsArray.hpp\"\n#include \"RowBinds.hpp\"\n\n\n"
+                      << "using namespace set_mysql_binds;\n\n\n";
 
    declaration_footer << "\n#endif //" << included_macro << '\n';
 }
@@ -47,36 +146,177 @@ static std::ostringstream createDefinitionHeader( const std::string& includeStr
    return os;
 }
 
+// The MysqlInputType enumerator name used in Bind<> for a field
+static std::string getBindTypeName( const Field& field ) {
+   std::string upperExternalType;
+   std::transform( field.externalType.begin(), field.externalType.end(),
+                   std::back_inserter( upperExternalType ), ::toupper );
+   if ( ( field.flags & UNSIGNED_FLAG ) == static_cast<int>( UNSIGNED_FLAG ) &&
+        ( upperExternalType == "INT" || upperExternalType == "TINYINT" ||
+          upperExternalType == "SMALLINT" || upperExternalType == "BIGINT" ||
+          upperExternalType == "MEDIUMINT" ) ) {
+      upperExternalType += "_UNSIGNED";
+   }
+   return upperExternalType;
+}
+
+// char[] binds are sized from the column definition, buff_size is the cap. DECIMAL needs room for
+// its digits, sign, decimal point and the leading 0 of DECIMAL(p,p) ("-0.xx"), columns with no
+// known length get the cap.
+static unsigned long getBufferSize( const Field& field, unsigned long buff_size ) {
+   unsigned long long size = field.maxLength;
+   if ( field.type == MYSQL_TYPE_NEWDECIMAL && field.numericPrecision ) {
+      size = field.numericPrecision + 3;
+   }
+   if ( !size || size > buff_size ) {
+      return buff_size;
+   }
+   return static_cast<unsigned long>( size );
+}
+
+// C type of a generated row struct member, must agree with BindType<>::outType (RowBinds.hpp
+// checks it at compile time). Types not listed are char[] columns.
+static std::string_view getRowMemberType( std::string_view bindTypeName ) {
+   static const std::unordered_map<std::string_view, std::string_view> memberTypes{
+       { "INT", "int" },
+       { "INT_UNSIGNED", "unsigned int" },
+       { "TINYINT", "signed char" },
+       { "TINYINT_UNSIGNED", "unsigned char" },
+       { "SMALLINT", "short" },
+       { "SMALLINT_UNSIGNED", "unsigned short" },
+       { "MEDIUMINT", "int" },
+       { "MEDIUMINT_UNSIGNED", "unsigned int" },
+       { "BIGINT", "long" },
+       { "BIGINT_UNSIGNED", "unsigned long" },
+       { "FLOAT", "float" },
+       { "DOUBLE", "double" },
+       { "BOOLEAN", "signed char" },
+       { "BIT", "unsigned long" },
+       { "DATE", "MYSQL_TIME" },
+       { "DATETIME", "MYSQL_TIME" },
+       { "TIMESTAMP", "MYSQL_TIME" },
+       { "TIME", "MYSQL_TIME" } };
+   auto it = memberTypes.find( bindTypeName );
+   return it == memberTypes.end() ? std::string_view{} : it->second;
+}
+
+// Emits the <table>Row struct to the declaration and its bind/fetch functions to the definition,
+// tableId and fieldIds are the identifiers of the table and its columns
+static void setRowStruct( std::ostringstream& declaration_body,
+                          std::ostringstream& definition_body, const Table& table,
+                          const std::string& tableId, const std::vector<std::string>& fieldIds,
+                          const std::vector<std::string>& bindTypeNames, unsigned long buff_size ) {
+   std::string rowType = tableId + "Row";
+   std::ostringstream members, paramBinds, resultBinds;
+   for ( size_t i = 0; i < table.fields.size(); ++i ) {
+      const std::string& name = fieldIds[ i ];
+      std::string_view memberType = getRowMemberType( bindTypeNames[ i ] );
+      std::string bindArgs = std::string( "( binds[ " ) + std::to_string( i ) + " ], row." + name;
+      if ( memberType.empty() ) {
+         members << "    unsigned char " << name << "[ "
+                 << getBufferSize( table.fields[ i ], buff_size ) << " ];\n"
+                 << "    unsigned long " << name << "_length;\n";
+         bindArgs += std::string( ", row." ) + name + "_length";
+      } else {
+         members << "    " << memberType << ' ' << name << ";\n";
+      }
+      members << "    bool " << name << "_isNull;\n";
+      bindArgs += std::string( ", row." ) + name + "_isNull );\n";
+
+      paramBinds << "    setRowBind<InputCType, " << bindTypeNames[ i ] << ">" << bindArgs;
+      resultBinds << "    setRowBind<OutputCType, " << bindTypeNames[ i ] << ">" << bindArgs;
+   }
+
+   std::string columnsConstant = rowType + "Columns";
+   std::string bindParams = std::string( "void bind" ) + rowType + "Params( " + rowType +
+                            "& row, MYSQL_BIND* binds )";
+   std::string bindResult = std::string( "void bind" ) + rowType + "Result( " + rowType +
+                            "& row, MYSQL_BIND* binds )";
+   std::string bindRowsParams = std::string( "void bind" ) + tableId + "RowsParams( std::span<" +
+                                rowType + "> rows, MYSQL_BIND* binds )";
+   std::string fetchRows = std::string( "size_t fetch" ) + tableId +
+                           "Rows( MYSQL_STMT* stmt, std::span<" + rowType + "> rows )";
+
+   declaration_body << "struct " << rowType << " {\n"
+                    << members.str() << "};\n"
+                    << "inline constexpr size_t " << columnsConstant << " = "
+                    << table.fields.size() << ";\n"
+                    << bindParams << ";\n"
+                    << bindResult << ";\n"
+                    << "// binds holds rows.size() * " << columnsConstant
+                    << ", one row after another, as for a multi-row INSERT\n"
+                    << bindRowsParams << ";\n"
+                    << fetchRows << ";\n\n";
+
+   definition_body << bindParams << "{\n" << paramBinds.str() << "}\n"
+                   << bindResult << "{\n" << resultBinds.str() << "}\n"
+                   << bindRowsParams << "{\n    for ( size_t i = 0; i < rows.size(); ++i ) {\n"
+                   << "        bind" << rowType << "Params( rows[ i ], binds + i * "
+                   << columnsConstant << " );\n    }\n}\n"
+                   << fetchRows << "{\n    return fetchRows<" << rowType << ", "
+                   << columnsConstant << ">( stmt, rows, bind" << rowType << "Result );\n}\n\n";
+}
+
+// Emits the <table>Column enum of column IDs and the <table>FieldHash perfect hash of the column
+// names, both in column order, for BindsArray::operator[]. The enumerators are the columns'
+// identifiers, the hash holds their names.
+static void setColumnIds( std::ostringstream& declaration_body, const Table& table,
+                          const std::string& tableId, const std::vector<std::string>& fieldIds ) {
+   std::ostringstream enumerators, names;
+   for ( size_t i = 0; i < table.fields.size(); ++i ) {
+      enumerators << ( i ? ", " : "" ) << fieldIds[ i ];
+      names << ( i ? ", " : "" ) << toStringLiteral( table.fields[ i ].name );
+   }
+   std::string count = std::to_string( table.fields.size() );
+   declaration_body << "enum class " << tableId << "Column : size_t { " << enumerators.str()
+                    << " };\n"
+                    << "inline constexpr FieldHash<" << count << "> " << tableId
+                    << "FieldHash( std::array<std::string_view, " << count << ">{ "
+                    << names.str() << " } );\n\n";
+}
+
+static void setTableBodies( std::ostringstream& declaration_body,
+                            std::ostringstream& definition_body, const Table& table,
+                            unsigned long buff_size ) {
+   const std::string tableId = toIdentifier( table.name );
+   const std::vector<std::string> fieldIds = fieldIdentifiers( table );
+   std::string funcReq =
+       std::string( "BindsArray<InputCType> " ) + tableId + "InputBindsArray()";
+   std::string funcRes =
+       std::string( "BindsArray<OutputCType> " ) + tableId + "OutputBindsArray()";
+   declaration_body << funcReq << ";\n" << funcRes << ";\n\n";
+   setColumnIds( declaration_body, table, tableId, fieldIds );
+
+   std::stringstream function_body;
+   std::vector<std::string> bindTypeNames;
+   int count = 0;
+   std::for_each( table.fields.begin(), table.fields.end(), [ & ]( const auto& field ) {
+      bindTypeNames.push_back( getBindTypeName( field ) );
+      function_body << ( count++ < 1 ? "" : ", " ) << "Bind<" << bindTypeNames.back() << ">("
+                    << toStringLiteral( field.name ) << ( isCharArray( field.type ) ? ", " : "" )
+                    << ( isCharArray( field.type )
+                             ? std::to_string( getBufferSize( field, buff_size ) )
+                             : "" )
+                    << ")";
+   } );
+   std::string useFieldHash = std::string( "    binds.useFieldHash( " ) + tableId +
+                              "FieldHash );\n    return binds;\n}\n";
+   definition_body << funcReq << "{\n    auto binds = makeInputBindsArray( "
+                   << function_body.str() << " );\n"
+                   << useFieldHash;
+   definition_body << funcRes << "{\n    auto binds = makeOutputBindsArray( "
+                   << std::move( function_body.str() ) << " );\n"
+                   << useFieldHash << '\n';
+
+   setRowStruct( declaration_body, definition_body, table, tableId, fieldIds, bindTypeNames,
+                 buff_size );
+}
+
 static void setFileBodies( std::ostringstream& declaration_body,
                            std::ostringstream& definition_body, std::span<const Table> tables,
                            unsigned long buff_size ) {
    std::for_each( tables.begin(), tables.end(), [ & ]( const auto& table ) {
-      std::string funcReq =
-          std::string( "BindsArray<InputCType> " ) + table.name + "InputBindsArray()";
-      std::string funcRes =
-          std::string( "BindsArray<OutputCType> " ) + table.name + "OutputBindsArray()";
-      declaration_body << funcReq << ";\n" << funcRes << ";\n\n";
-
-      std::stringstream function_body;
-      int count = 0;
-      std::for_each( table.fields.begin(), table.fields.end(), [ & ]( const auto& field ) {
-         std::string upperExternalType;
-         std::transform( field.externalType.begin(), field.externalType.end(),
-                         std::back_inserter( upperExternalType ), ::toupper );
-         if ( ( field.flags & UNSIGNED_FLAG ) == static_cast<int>( UNSIGNED_FLAG ) &&
-              ( upperExternalType == "INT" || upperExternalType == "TINYINT" ||
-                upperExternalType == "SMALLINT" || upperExternalType == "BIGINT" ||
-                upperExternalType == "MEDIUMINT" ) ) {
-            upperExternalType += "_UNSIGNED";
-         }
-         function_body << ( count++ < 1 ? "" : ", " ) << "Bind<" << upperExternalType << ">(\""
-                       << field.name << "\"" << ( isCharArray( field.type ) ? ", " : "" )
-                       << ( isCharArray( field.type ) ? std::to_string( buff_size ) : "" ) << ")";
-      } );
-      definition_body << funcReq << "{\n    return makeInputBindsArray( " << function_body.str()
-                      << " );\n}\n";
-      definition_body << funcRes << "{\n    return makeOutputBindsArray( "
-                      << std::move( function_body.str() ) << " );\n}\n\n";
+      setTableBodies( declaration_body, definition_body, table, buff_size );
    } );
 }
 
@@ -116,4 +356,133 @@ void createDBTableBinds( const std::string& host, const std::string& user,
    writeDefinitionFile( definition_header, definition_body, defnFile );
 }
 
+// FNV-1a, only used to tell whether a generated file changed
+static unsigned long long contentHash( std::string_view content ) {
+   unsigned long long hash = 14695981039346656037ULL;
+   for ( char c : content ) {
+      hash = ( hash ^ static_cast<unsigned char>( c ) ) * 1099511628211ULL;
+   }
+   return hash;
+}
+
+// Writes content to fileName unless the file already holds exactly that, so its timestamp and
+// everything the build system derives from it stay untouched. Returns whether it was written.
+static bool writeIfChanged( const std::filesystem::path& fileName, const std::string& content ) {
+   std::ifstream existing( fileName, std::ios::binary );
+   if ( existing ) {
+      std::string current( ( std::istreambuf_iterator<char>( existing ) ),
+                           std::istreambuf_iterator<char>() );
+      if ( current.size() == content.size() && contentHash( current ) == contentHash( content ) ) {
+         return false;
+      }
+   }
+   std::ofstream file( fileName, std::ios::binary | std::ios::trunc );
+   file << content;
+   if ( !file ) {
+      throw std::runtime_error( "could not write generated file " + fileName.string() + '\n' );
+   }
+   return true;
+}
+
+// Renders one table into <table>Binds.h/<table>Binds.cpp, named after the table's identifier,
+// returns how many files were rewritten
+static size_t writeTableFiles( const Table& table, const std::filesystem::path& outputDir,
+                               unsigned long buff_size ) {
+   const std::string tableId = toIdentifier( table.name );
+   std::ostringstream declaration_header, declaration_footer;
+   setDeclHeaderAndFooter( declaration_header, declaration_footer, tableId );
+   std::ostringstream definition_header = createDefinitionHeader( tableId + "Binds.h" );
+
+   std::ostringstream declaration_body, definition_body;
+   setTableBodies( declaration_body, definition_body, table, buff_size );
+
+   size_t written = 0;
+   written += writeIfChanged( outputDir / ( tableId + "Binds.h" ),
+                              declaration_header.str() + declaration_body.str() +
+                                  declaration_footer.str() );
+   written += writeIfChanged( outputDir / ( tableId + "Binds.cpp" ),
+                              definition_header.str() + definition_body.str() );
+   return written;
+}
+
+size_t createDBTableBindsPerTable( const std::string& host, const std::string& user,
+                                   const std::string& password, const std::string& database,
+                                   const std::string& outputDir, unsigned long buff_size,
+                                   unsigned int threads ) {
+   auto tables = getDBTables( host, user, password, database );
+   std::filesystem::create_directories( outputDir );
+
+   // Each table's files and the all tables header must have names of their own, or two writers
+   // would race for one file. Names are compared upper-cased, as the include guards are built from
+   // them and a case-insensitive file system would not tell Foo and foo apart either
+   const std::string allTablesName = toIdentifier( database ) + "All";
+   const auto upperCased = []( std::string name ) {
+      std::transform( name.begin(), name.end(), name.begin(), ::toupper );
+      return name;
+   };
+   std::unordered_set<std::string> fileNames{ upperCased( allTablesName ) };
+   std::for_each( tables.begin(), tables.end(), [ & ]( const auto& table ) {
+      if ( !fileNames.insert( upperCased( toIdentifier( table.name ) ) ).second ) {
+         throw std::runtime_error( "Table " + table.name + " would be generated as " +
+                                   toIdentifier( table.name ) +
+                                   "Binds.h, the name or include guard of another generated "
+                                   "header\n" );
+      }
+   } );
+
+   // Tables are rendered and written on a small pool of workers taking the next table in turn
+   if ( !threads ) {
+      threads = std::max( 1U, std::thread::hardware_concurrency() );
+   }
+   std::atomic<size_t> nextTable = 0;
+   std::atomic<size_t> written = 0;
+   std::vector<std::exception_ptr> errors( tables.size() );
+   {
+      std::vector<std::jthread> workers;
+      for ( unsigned int i = 0; i < std::min<size_t>( threads, tables.size() ); ++i ) {
+         workers.emplace_back( [ & ] {
+            for ( size_t t = nextTable++; t < tables.size(); t = nextTable++ ) {
+               try {
+                  written += writeTableFiles( tables[ t ], outputDir, buff_size );
+               } catch ( ... ) {
+                  errors[ t ] = std::current_exception();
+               }
+            }
+         } );
+      }
+   }
+   for ( const auto& error : errors ) {
+      if ( error ) {
+         std::rethrow_exception( error );
+      }
+   }
+
+   // One header including every table's header, and the manifest listing the generated files
+   std::ostringstream declaration_header, declaration_footer, includes;
+   setDeclHeaderAndFooter( declaration_header, declaration_footer, allTablesName );
+   const std::string dbId = toIdentifier( database );
+   std::string upper_db_name;
+   std::transform( dbId.begin(), dbId.end(), std::back_inserter( upper_db_name ), ::toupper );
+   std::ostringstream manifest;
+   manifest << "# This file was generated by createDBTableBindsPerTable() function\n"
+            << "set( " << upper_db_name << "_BINDS_HEADERS\n";
+   std::for_each( tables.begin(), tables.end(), [ & ]( const auto& table ) {
+      includes << "#include \"" << toIdentifier( table.name ) << "Binds.h\"\n";
+      manifest << "    ${CMAKE_CURRENT_LIST_DIR}/" << toIdentifier( table.name ) << "Binds.h\n";
+   } );
+   manifest << "    ${CMAKE_CURRENT_LIST_DIR}/" << allTablesName << "Binds.h\n)\n"
+            << "set( " << upper_db_name << "_BINDS_SOURCES\n";
+   std::for_each( tables.begin(), tables.end(), [ & ]( const auto& table ) {
+      manifest << "    ${CMAKE_CURRENT_LIST_DIR}/" << toIdentifier( table.name ) << "Binds.cpp\n";
+   } );
+   manifest << ")\n";
+
+   std::filesystem::path dir( outputDir );
+   written += writeIfChanged( dir / ( allTablesName + "Binds.h" ), declaration_header.str() +
+                                                                      includes.str() +
+                                                                      declaration_footer.str() );
+   written += writeIfChanged( dir / ( dbId + "Binds.cmake" ), manifest.str() );
+   return written;
+}
+
 }  // namespace set_mysql_binds
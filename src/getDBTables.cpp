@@ -1,119 +1,186 @@
 #include "getDBTables.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
 
+#include "ConnectionPool.h"
 #include "utilities.h"
 
 namespace set_mysql_binds {
 
-struct InputtedType {
-   std::string fieldName;
-   std::string type;
+// The whole schema in one set based query, joined to the tables client side
+static constexpr const char* columnsQuery =
+    "SELECT table_name, column_name, data_type, column_type, is_nullable, column_key, extra, "
+    "character_octet_length, numeric_precision, numeric_scale FROM information_schema.columns "
+    "WHERE table_schema = DATABASE() ORDER BY table_name, ordinal_position";
+
+enum ColumnsQueryField {
+   TABLE_NAME,
+   COLUMN_NAME,
+   DATA_TYPE,
+   COLUMN_TYPE,
+   IS_NULLABLE,
+   COLUMN_KEY,
+   EXTRA,
+   CHARACTER_OCTET_LENGTH,
+   NUMERIC_PRECISION,
+   NUMERIC_SCALE
 };
 
-std::vector<Table> getDBTables( const std::string& host, const std::string& user,
-                                const std::string& password, const std::string& database ) {
-   std::vector<Table> tables;
+static unsigned long long toUnsigned( const char* column ) {
+   return column ? std::strtoull( column, nullptr, 10 ) : 0;
+}
 
-   if ( mysql_library_init( 0, nullptr, nullptr ) ) {
-      std::cerr << "could not initialize MySQL client library\n";
-      exit( 1 );
-   }
+// The enum_field_types mysql_list_fields() reports for each information_schema DATA_TYPE
+static enum_field_types getFieldType( std::string_view dataType ) {
+   static const std::unordered_map<std::string_view, enum_field_types> fieldTypesByName{
+       { "tinyint", MYSQL_TYPE_TINY },
+       { "smallint", MYSQL_TYPE_SHORT },
+       { "mediumint", MYSQL_TYPE_INT24 },
+       { "int", MYSQL_TYPE_LONG },
+       { "integer", MYSQL_TYPE_LONG },
+       { "bigint", MYSQL_TYPE_LONGLONG },
+       { "float", MYSQL_TYPE_FLOAT },
+       { "double", MYSQL_TYPE_DOUBLE },
+       { "real", MYSQL_TYPE_DOUBLE },
+       { "decimal", MYSQL_TYPE_NEWDECIMAL },
+       { "numeric", MYSQL_TYPE_NEWDECIMAL },
+       { "date", MYSQL_TYPE_DATE },
+       { "datetime", MYSQL_TYPE_DATETIME },
+       { "timestamp", MYSQL_TYPE_TIMESTAMP },
+       { "time", MYSQL_TYPE_TIME },
+       { "year", MYSQL_TYPE_YEAR },
+       { "bit", MYSQL_TYPE_BIT },
+       { "char", MYSQL_TYPE_STRING },
+       { "binary", MYSQL_TYPE_STRING },
+       { "enum", MYSQL_TYPE_STRING },
+       { "set", MYSQL_TYPE_STRING },
+       { "varchar", MYSQL_TYPE_VAR_STRING },
+       { "varbinary", MYSQL_TYPE_VAR_STRING },
+       { "tinytext", MYSQL_TYPE_BLOB },
+       { "text", MYSQL_TYPE_BLOB },
+       { "mediumtext", MYSQL_TYPE_BLOB },
+       { "longtext", MYSQL_TYPE_BLOB },
+       { "tinyblob", MYSQL_TYPE_BLOB },
+       { "blob", MYSQL_TYPE_BLOB },
+       { "mediumblob", MYSQL_TYPE_BLOB },
+       { "longblob", MYSQL_TYPE_BLOB },
+       { "json", MYSQL_TYPE_JSON },
+       { "geometry", MYSQL_TYPE_GEOMETRY },
+       { "point", MYSQL_TYPE_GEOMETRY },
+       { "linestring", MYSQL_TYPE_GEOMETRY },
+       { "polygon", MYSQL_TYPE_GEOMETRY },
+       { "multipoint", MYSQL_TYPE_GEOMETRY },
+       { "multilinestring", MYSQL_TYPE_GEOMETRY },
+       { "multipolygon", MYSQL_TYPE_GEOMETRY },
+       { "geomcollection", MYSQL_TYPE_GEOMETRY },
+       { "geometrycollection", MYSQL_TYPE_GEOMETRY } };
+   auto it = fieldTypesByName.find( dataType );
+   return it == fieldTypesByName.end() ? MYSQL_TYPE_STRING : it->second;
+}
 
-   MYSQL* db_conn = mysql_init( nullptr );
-   if ( db_conn == nullptr ) {
-      std::cerr << "Error: " << mysql_error( db_conn ) << '\n';
-      mysql_library_end();
-      exit( 1 );
-   }
+// The field flags mysql_list_fields() reports, rebuilt from the column definition
+static unsigned long getFieldFlags( MYSQL_ROW row, enum_field_types type ) {
+   std::string_view dataType = row[ DATA_TYPE ];
+   std::string_view columnType = row[ COLUMN_TYPE ];
+   std::string_view columnKey = row[ COLUMN_KEY ] ? row[ COLUMN_KEY ] : "";
+   std::string_view extra = row[ EXTRA ] ? row[ EXTRA ] : "";
 
-   if ( mysql_real_connect( db_conn, host.c_str(), user.c_str(), password.c_str(), database.c_str(),
-                            0, nullptr, 0 ) == nullptr ) {
-      std::cerr << "Error: " << mysql_error( db_conn ) << '\n';
-      mysql_close( db_conn );
-      mysql_library_end();
-      exit( 1 );
+   unsigned long flags = 0;
+   if ( std::string_view( row[ IS_NULLABLE ] ) == "NO" ) {
+      flags |= NOT_NULL_FLAG;
    }
-
-   // Get a list of all tables in the selected database
-   MYSQL_RES* res = mysql_list_tables( db_conn, nullptr );
-   if ( res == nullptr ) {
-      std::cerr << "Error: " << mysql_error( db_conn ) << std::endl;
-      mysql_close( db_conn );
-      mysql_library_end();
-      exit( 1 );
+   if ( columnKey == "PRI" ) {
+      flags |= PRI_KEY_FLAG;
+   } else if ( columnKey == "UNI" ) {
+      flags |= UNIQUE_KEY_FLAG;
+   } else if ( columnKey == "MUL" ) {
+      flags |= MULTIPLE_KEY_FLAG;
    }
+   if ( columnType.find( "unsigned" ) != std::string_view::npos ) {
+      flags |= UNSIGNED_FLAG;
+   }
+   if ( columnType.find( "zerofill" ) != std::string_view::npos ) {
+      flags |= ZEROFILL_FLAG;
+   }
+   if ( extra.find( "auto_increment" ) != std::string_view::npos ) {
+      flags |= AUTO_INCREMENT_FLAG;
+   }
+   if ( type == MYSQL_TYPE_BLOB || type == MYSQL_TYPE_JSON || type == MYSQL_TYPE_GEOMETRY ) {
+      flags |= BLOB_FLAG;
+   }
+   if ( dataType.find( "binary" ) != std::string_view::npos ||
+        dataType.find( "blob" ) != std::string_view::npos ) {
+      flags |= BINARY_FLAG;
+   }
+   if ( dataType == "enum" ) {
+      flags |= ENUM_FLAG;
+   } else if ( dataType == "set" ) {
+      flags |= SET_FLAG;
+   }
+   return flags;
+}
 
-   // Tables in database
-   for ( long unsigned int i = 0; i < mysql_num_rows( res ); i++ ) {
-      tables.emplace_back();
-      MYSQL_ROW row = mysql_fetch_row( res );
-      tables.back().name = row[ 0 ];
-
-      // Get the fields and internal field types of the current table
-      MYSQL_RES* fields = mysql_list_fields( db_conn, row[ 0 ], nullptr );
-      if ( fields == nullptr ) {
-         std::cerr << "Error: " << mysql_error( db_conn ) << std::endl;
-         mysql_free_result( res );
-         mysql_close( db_conn );
-         mysql_library_end();
-
-         exit( 1 );
-      }
-
-      std::stringstream ss;
-      ss << "SELECT column_name, data_type FROM information_schema.columns "
-            "WHERE table_name = \'"
-         << row[ 0 ] << "\'";
-      std::string query = ss.str();
+std::vector<Table> getDBTables( MYSQL* db_conn ) {
+   std::vector<Table> tables;
 
-      if ( mysql_query( db_conn, query.c_str() ) ) {
-         std::cerr << "Error: " << mysql_error( db_conn ) << std::endl;
-         mysql_free_result( res );
-         mysql_close( db_conn );
-         mysql_library_end();
+   // One round trip for every column of every table in the selected database, filtered on the
+   // schema so same-named tables of other databases are not picked up
+   MYSQL_RES* res = nullptr;
+   if ( mysql_query( db_conn, columnsQuery ) ||
+        ( res = mysql_store_result( db_conn ) ) == nullptr ) {
+      throw std::runtime_error( mysql_error( db_conn ) );
+   }
 
-         exit( 1 );
-      }
-      MYSQL_RES* userInputtedData;
-      userInputtedData = mysql_store_result( db_conn );
-      if ( !userInputtedData ) {
-         std::cerr << "Error: " << mysql_error( db_conn ) << std::endl;
-         mysql_free_result( res );
-         mysql_close( db_conn );
-         mysql_library_end();
-
-         exit( 1 );
+   std::unordered_map<std::string, size_t> tableIndexes;
+   tableIndexes.reserve( mysql_num_rows( res ) );
+   MYSQL_ROW row;
+   while ( ( row = mysql_fetch_row( res ) ) ) {
+      auto [ it, inserted ] = tableIndexes.try_emplace( row[ TABLE_NAME ], tables.size() );
+      if ( inserted ) {
+         tables.emplace_back();
+         tables.back().name = row[ TABLE_NAME ];
       }
 
-      MYSQL_ROW dataTypeRow;
-      std::vector<InputtedType> inputtedTypes;
-      // Results obtained in different loops because output sequence of the 2 fetch
-      // function results do not always match. Instead must use std::find_if() with these
-      // results in the loop after this one.
-      while ( ( dataTypeRow = mysql_fetch_row( userInputtedData ) ) ) {
-         inputtedTypes.emplace_back( dataTypeRow[ 0 ], dataTypeRow[ 1 ] );
-      }
+      enum_field_types type = getFieldType( row[ DATA_TYPE ] );
+      tables[ it->second ].fields.emplace_back(
+          row[ COLUMN_NAME ], type, getFieldFlags( row, type ), row[ DATA_TYPE ],
+          toUnsigned( row[ CHARACTER_OCTET_LENGTH ] ),
+          static_cast<unsigned int>( toUnsigned( row[ NUMERIC_PRECISION ] ) ),
+          static_cast<unsigned int>( toUnsigned( row[ NUMERIC_SCALE ] ) ) );
+   }
 
-      for ( unsigned int j = 0; j < mysql_num_fields( fields ); j++ ) {
-         MYSQL_FIELD* field = mysql_fetch_field_direct( fields, j );
-         auto it = std::find_if( inputtedTypes.begin(), inputtedTypes.end(),
-                                 [ & ]( const auto& s ) { return s.fieldName == field->name; } );
+   mysql_free_result( res );
+   return tables;
+}
 
-         tables.back().fields.emplace_back( field->name, field->type, field->flags, it->type );
-      }
+std::vector<Table> getDBTables( const std::string& host, const std::string& user,
+                                const std::string& password, const std::string& database ) {
+   MYSQL* db_conn = nullptr;
+   try {
+      db_conn = openConnection( { host, user, password, database } );
+   } catch ( const std::runtime_error& e ) {
+      std::cerr << "Error: " << e.what() << '\n';
+      exit( 1 );
+   }
 
-      mysql_free_result( fields );
-      mysql_free_result( userInputtedData );
+   std::vector<Table> tables;
+   try {
+      tables = getDBTables( db_conn );
+   } catch ( const std::runtime_error& e ) {
+      std::cerr << "Error: " << e.what() << std::endl;
+      mysql_close( db_conn );
+      exit( 1 );
    }
 
-   mysql_free_result( res );
    mysql_close( db_conn );
-   mysql_library_end();
    return tables;
 }
 
@@ -48,7 +48,35 @@ const std::array<std::string_view, 256> fieldTypes = getFieldTypesArray();
 // in prepared statements
 bool isCharArray( enum_field_types type ) {
    int enumValue = static_cast<int>( type );
-   return ( ( enumValue > 248 && enumValue < 255 ) || enumValue == 246 );
+   return ( ( enumValue > 248 && enumValue <= 255 ) || enumValue == 246 || enumValue == 245 );
+}
+
+unsigned long fixedBufferSize( enum_field_types type ) {
+   switch ( type ) {
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_BOOL:
+         return sizeof( signed char );
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_YEAR:
+         return sizeof( short );
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_INT24:
+         return sizeof( int );
+      case MYSQL_TYPE_LONGLONG:
+      case MYSQL_TYPE_BIT:
+         return sizeof( long );
+      case MYSQL_TYPE_FLOAT:
+         return sizeof( float );
+      case MYSQL_TYPE_DOUBLE:
+         return sizeof( double );
+      case MYSQL_TYPE_DATE:
+      case MYSQL_TYPE_TIME:
+      case MYSQL_TYPE_DATETIME:
+      case MYSQL_TYPE_TIMESTAMP:
+         return sizeof( MYSQL_TIME );
+      default:
+         return 0;
+   }
 }
 
 bool strict_fundamental_type_checking = false;